@@ -0,0 +1,11 @@
+a: array<number>
+i := 0
+while i < 200000
+  add(a, (i * 7919) % 100003)
+  i += 1
+total := 0
+for x : a
+  if x % 2 == 0
+    total += x
+sort(a)
+print total + a[0] + a[199999] + binarySearch(a, a[1000])
@@ -0,0 +1,5 @@
+fib: (n: number): number
+  if n < 2
+    return n
+  return fib(n - 1) + fib(n - 2)
+print fib(25)
@@ -0,0 +1,10 @@
+square: (x: number): number
+  return x * x
+addSquares: (a: number, b: number): number
+  return square(a) + square(b)
+total := 0
+i := 0
+while i < 80000
+  total += addSquares(i % 10, 3)
+  i += 1
+print total
@@ -0,0 +1,10 @@
+out := openWrite("io_benchmark.txt")
+i := 0
+while i < 120000
+  writeLine(out, toString(i) + ",value," + toString(i % 97))
+  i += 1
+close(out)
+total := 0
+for line : readLines("io_benchmark.txt")
+  total += toNumber(split(line, ",")[2])
+print total + len(readFile("io_benchmark.txt"))
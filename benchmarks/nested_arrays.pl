@@ -0,0 +1,22 @@
+m: array<array<number>>
+i := 0
+while i < 300
+  row: array<number>
+  j := 0
+  while j < 300
+    add(row, (i + j) % 7)
+    j += 1
+  add(m, row)
+  i += 1
+total := 0
+k := 0
+while k < 300
+  row := m[k]
+  j := 0
+  while j < 300
+    total += row[j] * (k % 3)
+    j += 1
+  k += 1
+for r : m
+  total += sum(r)
+print total
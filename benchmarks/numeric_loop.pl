@@ -0,0 +1,6 @@
+total := 0
+i := 0
+while i < 250000
+  total += (i * 3 + 7) % 11 - i / 4
+  i += 1
+print total
@@ -0,0 +1,239 @@
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Runs every script listed in suite.txt through the interpreter and reports median wall time, peak RSS and
+// throughput. Each line of the suite is: name, script, work units per run, unit name, expected output
+
+namespace {
+struct Benchmark {
+  std::string name;
+  std::string script;
+  double units = 0;
+  std::string unit;
+  std::string expected;
+};
+
+struct Result {
+  double medianMs = 0;
+  double minMs = 0;
+  long peakRssKib = 0;
+  std::string error;
+};
+
+struct Run {
+  double ms;
+  long peakRssKib;
+  std::string output;
+  int status;
+};
+
+std::vector<Benchmark> readSuite(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("can not open " + path);
+  }
+  std::vector<Benchmark> suite;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::istringstream fields(line);
+    Benchmark benchmark;
+    if (!(fields >> benchmark.name)) {
+      continue;
+    }
+    if (!(fields >> benchmark.script >> benchmark.units >> benchmark.unit >> benchmark.expected)) {
+      throw std::runtime_error("malformed line in " + path + ": " + line);
+    }
+    suite.push_back(benchmark);
+  }
+  return suite;
+}
+
+// the script's output goes to a file next to the working directory so that it can be checked afterwards
+Run runOnce(const std::string& interpreter, const std::string& script, const std::string& outputPath) {
+  auto start = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if (pid < 0) {
+    throw std::runtime_error(std::string("fork: ") + std::strerror(errno));
+  }
+  if (pid == 0) {
+    int input = open("/dev/null", O_RDONLY);
+    int output = open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (input < 0 || output < 0) {
+      _exit(127);
+    }
+    dup2(input, STDIN_FILENO);
+    dup2(output, STDOUT_FILENO);
+    dup2(output, STDERR_FILENO);
+    execl(interpreter.c_str(), interpreter.c_str(), script.c_str(), static_cast<char*>(nullptr));
+    _exit(127);
+  }
+  int status = 0;
+  struct rusage usage{};
+  while (wait4(pid, &status, 0, &usage) < 0) {
+    if (errno != EINTR) {
+      throw std::runtime_error(std::string("wait4: ") + std::strerror(errno));
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  Run run{std::chrono::duration<double, std::milli>(end - start).count(), usage.ru_maxrss, "", status};
+  std::ifstream file(outputPath);
+  run.output.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  while (!run.output.empty() && (run.output.back() == '\n' || run.output.back() == ' ')) {
+    run.output.pop_back();
+  }
+  return run;
+}
+
+Result measure(const std::string& interpreter, const std::string& directory, const Benchmark& benchmark,
+               int warmups, int runs) {
+  Result result;
+  std::vector<double> times;
+  std::string outputPath = benchmark.name + ".out";
+  for (int i = 0; i < warmups + runs; ++i) {
+    Run run = runOnce(interpreter, directory + "/" + benchmark.script, outputPath);
+    if (!WIFEXITED(run.status) || WEXITSTATUS(run.status) != 0) {
+      result.error = "interpreter exited abnormally";
+      return result;
+    }
+    if (run.output != benchmark.expected) {
+      result.error = "unexpected output: " + run.output.substr(0, 200);
+      return result;
+    }
+    if (i >= warmups) {
+      times.push_back(run.ms);
+      result.peakRssKib = std::max(result.peakRssKib, run.peakRssKib);
+    }
+  }
+  std::sort(times.begin(), times.end());
+  size_t middle = times.size() / 2;
+  result.medianMs = times.size() % 2 == 1 ? times[middle] : (times[middle - 1] + times[middle]) / 2;
+  result.minMs = times.front();
+  std::remove(outputPath.c_str());
+  return result;
+}
+
+std::string escapeJson(const std::string& text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char code[8];
+      std::snprintf(code, sizeof(code), "\\u%04x", c);
+      escaped += code;
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+void usage(const char* program) {
+  std::cerr << "usage: " << program << " <interpreter> <benchmark directory> [--runs N] [--warmups N]"
+            << " [--json file] [--filter name]\n";
+}
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    usage(argv[0]);
+    return 2;
+  }
+  std::string interpreter = argv[1];
+  std::string directory = argv[2];
+  int runs = 5;
+  int warmups = 1;
+  std::string jsonPath;
+  std::string filter;
+  for (int i = 3; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      usage(argv[0]);
+      return 2;
+    }
+    if (arg == "--runs") {
+      runs = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--warmups") {
+      warmups = std::max(0, std::atoi(argv[++i]));
+    } else if (arg == "--json") {
+      jsonPath = argv[++i];
+    } else if (arg == "--filter") {
+      filter = argv[++i];
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  std::vector<Benchmark> suite;
+  try {
+    suite = readSuite(directory + "/suite.txt");
+  } catch (std::exception& e) {
+    std::cerr << e.what() << "\n";
+    return 2;
+  }
+
+  std::ostringstream json;
+  json << std::fixed << std::setprecision(3);
+  json << "{\n  \"interpreter\": \"" << escapeJson(interpreter) << "\",\n  \"runs\": " << runs
+       << ",\n  \"warmups\": " << warmups << ",\n  \"benchmarks\": [";
+  std::cout << std::left << std::setw(16) << "benchmark" << std::right << std::setw(12) << "median ms"
+            << std::setw(12) << "min ms" << std::setw(14) << "peak RSS KiB" << std::setw(26) << "throughput" << "\n";
+  bool failed = false;
+  bool first = true;
+  for (const auto& benchmark : suite) {
+    if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+      continue;
+    }
+    Result result;
+    try {
+      result = measure(interpreter, directory, benchmark, warmups, runs);
+    } catch (std::exception& e) {
+      result.error = e.what();
+    }
+    json << (first ? "\n" : ",\n") << "    {\"name\": \"" << escapeJson(benchmark.name) << "\"";
+    first = false;
+    if (!result.error.empty()) {
+      failed = true;
+      std::cout << std::left << std::setw(16) << benchmark.name << "FAILED: " << result.error << "\n";
+      json << ", \"error\": \"" << escapeJson(result.error) << "\"}";
+      continue;
+    }
+    double throughput = benchmark.units / (result.medianMs / 1000);
+    std::ostringstream rate;
+    rate << std::fixed << std::setprecision(0) << throughput << " " << benchmark.unit << "/s";
+    std::cout << std::left << std::setw(16) << benchmark.name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << result.medianMs << std::setw(12) << result.minMs << std::setw(14)
+              << result.peakRssKib << std::setw(26) << rate.str() << "\n";
+    json << ", \"median_ms\": " << result.medianMs << ", \"min_ms\": " << result.minMs
+         << ", \"peak_rss_kib\": " << result.peakRssKib << ", \"units\": " << std::setprecision(0) << benchmark.units
+         << std::setprecision(3) << ", \"unit\": \"" << escapeJson(benchmark.unit) << "\", \"throughput\": "
+         << throughput << "}";
+  }
+  json << "\n  ]\n}\n";
+  if (!jsonPath.empty()) {
+    std::ofstream file(jsonPath);
+    file << json.str();
+    if (!file) {
+      std::cerr << "can not write " << jsonPath << "\n";
+      return 2;
+    }
+    std::cout << "results written to " << jsonPath << "\n";
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,11 @@
+s := ""
+i := 0
+while i < 50000
+  s += toString(i % 10)
+  if i % 100 == 99
+    s += ","
+  i += 1
+total := 0
+for part : split(s, ",")
+  total += len(part)
+print total + len(replace(s, "99", "x"))
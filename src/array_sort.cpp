@@ -0,0 +1,100 @@
+#include "array_sort.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "thread_pool.h"
+
+namespace {
+const size_t PARALLEL_SORT_THRESHOLD = 1 << 15;
+
+// NaN is ordered after every other number so that the comparison stays a strict weak ordering
+bool lessNumber(const Rvalue* lhs, const Rvalue* rhs) {
+  double a = static_cast<const NumberRvalue*>(lhs)->getValue();
+  double b = static_cast<const NumberRvalue*>(rhs)->getValue();
+  return a < b || (std::isnan(b) && !std::isnan(a));
+}
+
+bool lessString(const Rvalue* lhs, const Rvalue* rhs) {
+  return static_cast<const StringRvalue*>(lhs)->getValue() < static_cast<const StringRvalue*>(rhs)->getValue();
+}
+}
+
+void ArraySort::sort(Elements& elements, int elementType) {
+  if (elementType == TYPE_NUMBER) {
+    sort(elements, lessNumber);
+  } else {
+    sort(elements, lessString);
+  }
+}
+
+long ArraySort::binarySearch(const Elements& elements, int elementType, const Rvalue* value) {
+  if (elementType == TYPE_NUMBER) {
+    return binarySearch(elements, value, lessNumber);
+  }
+  return binarySearch(elements, value, lessString);
+}
+
+template<typename Less>
+void ArraySort::sort(Elements& elements, Less lessValue) {
+  auto less = [lessValue](const std::shared_ptr<Rvalue>& lhs, const std::shared_ptr<Rvalue>& rhs) {
+    return lessValue(lhs.get(), rhs.get());
+  };
+  auto& pool = ThreadPool::getInstance();
+  size_t size = elements.size();
+  size_t runs = pool.getSize();
+  if (size < PARALLEL_SORT_THRESHOLD || runs == 1) {
+    std::stable_sort(elements.begin(), elements.end(), less);
+    return;
+  }
+  std::vector<size_t> bounds;
+  for (size_t i = 0; i <= runs; ++i) {
+    bounds.push_back(size * i / runs);
+  }
+  pool.parallelFor(runs, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      std::stable_sort(elements.begin() + bounds[i], elements.begin() + bounds[i + 1], less);
+    }
+  });
+  // merge neighbouring runs pairwise until one is left, alternating between the array and a buffer
+  Elements buffer(size);
+  Elements* from = &elements;
+  Elements* to = &buffer;
+  while (bounds.size() > 2) {
+    size_t pairs = bounds.size() / 2;
+    pool.parallelFor(pairs, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) {
+        size_t first = bounds[2 * i];
+        size_t middle = bounds[std::min(2 * i + 1, bounds.size() - 1)];
+        size_t last = bounds[std::min(2 * i + 2, bounds.size() - 1)];
+        std::merge(std::make_move_iterator(from->begin() + first), std::make_move_iterator(from->begin() + middle),
+                   std::make_move_iterator(from->begin() + middle), std::make_move_iterator(from->begin() + last),
+                   to->begin() + first, less);
+      }
+    });
+    std::vector<size_t> merged;
+    for (size_t i = 0; i < bounds.size(); i += 2) {
+      merged.push_back(bounds[i]);
+    }
+    if (merged.back() != size) {
+      merged.push_back(size);
+    }
+    bounds = std::move(merged);
+    std::swap(from, to);
+  }
+  if (from != &elements) {
+    elements = std::move(buffer);
+  }
+}
+
+template<typename Less>
+long ArraySort::binarySearch(const Elements& elements, const Rvalue* value, Less less) {
+  auto it = std::lower_bound(elements.begin(), elements.end(), value,
+                             [less](const std::shared_ptr<Rvalue>& element, const Rvalue* key) {
+                               return less(element.get(), key);
+                             });
+  if (it == elements.end() || less(value, it->get())) {
+    return -1;
+  }
+  return it - elements.begin();
+}
@@ -0,0 +1,25 @@
+#ifndef PROG_LANG_ARRAY_SORT_H
+#define PROG_LANG_ARRAY_SORT_H
+
+#include <memory>
+#include <vector>
+
+#include "value.h"
+
+// Ordering of number and string array elements; large arrays are sorted in chunks on the thread pool and merged
+class ArraySort {
+ public:
+  using Elements = std::vector<std::shared_ptr<Rvalue>>;
+
+  static void sort(Elements& elements, int elementType);
+  // index of an element equal to value in a sorted array, or -1
+  static long binarySearch(const Elements& elements, int elementType, const Rvalue* value);
+
+ private:
+  template<typename Less>
+  static void sort(Elements& elements, Less less);
+  template<typename Less>
+  static long binarySearch(const Elements& elements, const Rvalue* value, Less less);
+};
+
+#endif //PROG_LANG_ARRAY_SORT_H
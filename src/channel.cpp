@@ -0,0 +1,112 @@
+#include "channel.h"
+
+#include <algorithm>
+
+#include "thread_pool.h"
+
+Channel::Channel(size_t capacity)
+    : capacity(capacity), slotCount(std::max<size_t>(capacity, 2)), slots(new Slot[slotCount]), head(0), tail(0),
+      closed(false), waitingSenders(0), waitingReceivers(0) {
+  for (size_t i = 0; i < slotCount; ++i) {
+    slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool Channel::send(std::shared_ptr<Rvalue> value) {
+  if (closed) {
+    return false;
+  }
+  if (!tryPush(value)) {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++waitingSenders;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool sent;
+    while (!(sent = tryPush(value)) && !closed) {
+      ThreadPool::getInstance().block([&]() { notFull.wait(lock); });
+    }
+    --waitingSenders;
+    if (!sent) {
+      return false;
+    }
+  }
+  wake(waitingReceivers, notEmpty);
+  return true;
+}
+
+bool Channel::receive(std::shared_ptr<Rvalue>& value) {
+  if (!tryPop(value)) {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++waitingReceivers;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool received;
+    while (!(received = tryPop(value)) && !closed) {
+      ThreadPool::getInstance().block([&]() { notEmpty.wait(lock); });
+    }
+    // values sent right before the channel was closed are still delivered
+    received = received || tryPop(value);
+    --waitingReceivers;
+    if (!received) {
+      return false;
+    }
+  }
+  wake(waitingSenders, notFull);
+  return true;
+}
+
+void Channel::close() {
+  closed = true;
+  std::lock_guard<std::mutex> lock(mutex);
+  notFull.notify_all();
+  notEmpty.notify_all();
+}
+
+bool Channel::tryPush(std::shared_ptr<Rvalue>& value) {
+  size_t position = head.load(std::memory_order_relaxed);
+  while (true) {
+    Slot& slot = slots[position % slotCount];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == position) {
+      // a stale tail only makes the channel look fuller, and the sender then retries under the mutex
+      if (slotCount > capacity && position - tail.load(std::memory_order_acquire) >= capacity) {
+        return false;
+      }
+      if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        slot.value = std::move(value);
+        slot.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (sequence < position) {
+      return false;
+    } else {
+      position = head.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool Channel::tryPop(std::shared_ptr<Rvalue>& value) {
+  size_t position = tail.load(std::memory_order_relaxed);
+  while (true) {
+    Slot& slot = slots[position % slotCount];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (sequence == position + 1) {
+      if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        value = std::move(slot.value);
+        slot.sequence.store(position + slotCount, std::memory_order_release);
+        return true;
+      }
+    } else if (sequence < position + 1) {
+      return false;
+    } else {
+      position = tail.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void Channel::wake(const std::atomic<int>& waiting, std::condition_variable& condition) {
+  // pairs with the fence after a waiter registers itself, so either the waiter sees the change or we see the waiter
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (waiting > 0) {
+    std::lock_guard<std::mutex> lock(mutex);
+    condition.notify_all();
+  }
+}
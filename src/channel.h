@@ -0,0 +1,46 @@
+#ifndef PROG_LANG_CHANNEL_H
+#define PROG_LANG_CHANNEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "value.h"
+
+// Bounded multi-producer multi-consumer queue shared by tasks. The ring buffer itself is lock-free; the mutex is only
+// taken to sleep while the channel is full or empty
+class Channel {
+ public:
+  explicit Channel(size_t capacity);
+  // false if the channel is closed
+  bool send(std::shared_ptr<Rvalue> value);
+  // false once the channel is closed and drained
+  bool receive(std::shared_ptr<Rvalue>& value);
+  void close();
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    std::shared_ptr<Rvalue> value;
+  };
+
+  bool tryPush(std::shared_ptr<Rvalue>& value);
+  bool tryPop(std::shared_ptr<Rvalue>& value);
+  void wake(const std::atomic<int>& waiting, std::condition_variable& condition);
+
+  size_t capacity;
+  // a single slot can not tell a full ring from one that a sender may fill again, so capacity 1 keeps a spare slot
+  size_t slotCount;
+  std::unique_ptr<Slot[]> slots;
+  alignas(64) std::atomic<size_t> head;
+  alignas(64) std::atomic<size_t> tail;
+  std::atomic<bool> closed;
+  std::atomic<int> waitingSenders;
+  std::atomic<int> waitingReceivers;
+  std::mutex mutex;
+  std::condition_variable notFull;
+  std::condition_variable notEmpty;
+};
+
+#endif //PROG_LANG_CHANNEL_H
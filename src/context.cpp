@@ -0,0 +1,44 @@
+#include "context.h"
+
+#include <sstream>
+
+Context::Context(std::istream& input, std::ostream& output)
+    : moduleLoader(*this), input(input), output(output), scanner(std::make_shared<InputScanner>(input, &output)),
+      lazyFunctionAnalysis(false) {}
+
+Context::Context(Context& parent)
+    : store(&parent.store), moduleLoader(*this), input(parent.input), output(parent.output), scanner(parent.scanner),
+      lazyFunctionAnalysis(parent.lazyFunctionAnalysis) {}
+
+Context::~Context() {
+  std::ostringstream discarded;
+  for (const auto& task : tasks) {
+    try {
+      task->await(discarded);
+    } catch (...) {
+    }
+  }
+}
+
+Store& Context::getStore() { return store; }
+
+ModuleLoader& Context::getModuleLoader() { return moduleLoader; }
+
+std::istream& Context::getInput() const { return input; }
+
+InputScanner& Context::getScanner() { return *scanner; }
+
+std::ostream& Context::getOutput() const { return output; }
+
+bool Context::isLazyFunctionAnalysis() const { return lazyFunctionAnalysis; }
+
+void Context::setLazyFunctionAnalysis(bool lazy) { lazyFunctionAnalysis = lazy; }
+
+void Context::addTask(std::shared_ptr<Task> task) { tasks.push_back(std::move(task)); }
+
+void Context::joinTasks() {
+  for (const auto& task : tasks) {
+    task->await(output);
+  }
+  tasks.clear();
+}
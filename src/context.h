@@ -0,0 +1,41 @@
+#ifndef PROG_LANG_CONTEXT_H
+#define PROG_LANG_CONTEXT_H
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "input_scanner.h"
+#include "module_loader.h"
+#include "store.h"
+#include "task.h"
+
+class Context {
+ public:
+  explicit Context(std::istream& input = std::cin, std::ostream& output = std::cout);
+  explicit Context(Context& parent);
+  Context(const Context&) = delete;
+  Context& operator=(const Context&) = delete;
+  ~Context();
+
+  Store& getStore();
+  ModuleLoader& getModuleLoader();
+  std::istream& getInput() const;
+  InputScanner& getScanner();
+  std::ostream& getOutput() const;
+  bool isLazyFunctionAnalysis() const;
+  void setLazyFunctionAnalysis(bool lazy);
+  void addTask(std::shared_ptr<Task> task);
+  void joinTasks();
+
+ private:
+  Store store;
+  ModuleLoader moduleLoader;
+  std::istream& input;
+  std::ostream& output;
+  std::shared_ptr<InputScanner> scanner;
+  bool lazyFunctionAnalysis;
+  std::vector<std::shared_ptr<Task>> tasks;
+};
+
+#endif //PROG_LANG_CONTEXT_H
@@ -1,168 +1,100 @@
 #include "expression_parser.h"
 
-#include <algorithm>
-#include <map>
+#include <array>
 
+#include "parser.h"
 #include "syntax_error.h"
 
 namespace {
-typedef std::vector<OperatorTokenType> TokenVector;
-std::unique_ptr<TokenVector> assignmentOpTokens;
-std::unique_ptr<TokenVector> predicateTokens;
-std::unique_ptr<TokenVector> additionOpTokens;
-std::unique_ptr<TokenVector> multiplicationOpTokens;
-std::unique_ptr<TokenVector> unaryOpTokens;
-
-void initializeTokenVector(std::unique_ptr<TokenVector>& v, std::initializer_list<OperatorTokenType> init) {
-  v = std::make_unique<TokenVector>(init);
-}
-
-typedef std::map<OperatorTokenType, UnaryOperatorNode::UnaryOperator> UnaryOpMap;
-std::unique_ptr<UnaryOpMap> unaryOpNodeMap;
-
-typedef std::map<OperatorTokenType, BinaryOperatorNode::BinaryOperator> BinaryOpMap;
-std::unique_ptr<BinaryOpMap> binaryOpNodeMap;
-}
-
-void ExpressionParser::initializeData() {
-  initializeTokenVector(assignmentOpTokens, {
-      OP_EQUALS,
-      OP_PLUS_EQUALS,
-      OP_MINUS_EQUALS,
-      OP_ASTERISK_EQUALS,
-      OP_SLASH_EQUALS,
-      OP_PERCENT_EQUALS,
-      OP_AND_EQUALS,
-      OP_OR_EQUALS
-  });
-
-  initializeTokenVector(predicateTokens, {
-      OP_IS_EQUAL_TO,
-      OP_IS_LESS_THAN,
-      OP_IS_GREATER_THAN,
-      OP_IS_LESS_EQUAL,
-      OP_IS_GREATER_EQUAL,
-      OP_IS_DIFFERENT
-  });
-
-  initializeTokenVector(additionOpTokens, {
-      OP_PLUS,
-      OP_MINUS
-  });
-
-  initializeTokenVector(multiplicationOpTokens, {
-      OP_ASTERISK,
-      OP_SLASH,
-      OP_PERCENT
-  });
-
-  initializeTokenVector(unaryOpTokens, {
-      OP_PLUS,
-      OP_MINUS,
-      OP_NOT
-  });
-
-  UnaryOpMap unary{
-      {OP_PLUS, UnaryOperatorNode::PLUS},
-      {OP_MINUS, UnaryOperatorNode::MINUS},
-      {OP_NOT, UnaryOperatorNode::NOT}
-  };
-  unaryOpNodeMap = std::make_unique<UnaryOpMap>(std::move(unary));
-
-  BinaryOpMap binary{
-      {OP_EQUALS, BinaryOperatorNode::ASSIGN},
-      {OP_PLUS_EQUALS, BinaryOperatorNode::ADD_ASSIGN},
-      {OP_MINUS_EQUALS, BinaryOperatorNode::SUBTRACT_ASSIGN},
-      {OP_ASTERISK_EQUALS, BinaryOperatorNode::MULTIPLY_ASSIGN},
-      {OP_SLASH_EQUALS, BinaryOperatorNode::DIVIDE_ASSIGN},
-      {OP_PERCENT_EQUALS, BinaryOperatorNode::REMAINDER_ASSIGN},
-      {OP_OR_EQUALS, BinaryOperatorNode::OR_ASSIGN},
-      {OP_AND_EQUALS, BinaryOperatorNode::AND_ASSIGN},
-      {OP_IS_EQUAL_TO, BinaryOperatorNode::EQUAL},
-      {OP_IS_LESS_THAN, BinaryOperatorNode::LESS},
-      {OP_IS_GREATER_THAN, BinaryOperatorNode::GREATER},
-      {OP_IS_LESS_EQUAL, BinaryOperatorNode::LESS_EQUAL},
-      {OP_IS_GREATER_EQUAL, BinaryOperatorNode::GREATER_EQUAL},
-      {OP_IS_DIFFERENT, BinaryOperatorNode::DIFFERENT},
-      {OP_PLUS, BinaryOperatorNode::ADD},
-      {OP_MINUS, BinaryOperatorNode::SUBTRACT},
-      {OP_ASTERISK, BinaryOperatorNode::MULTIPLY},
-      {OP_SLASH, BinaryOperatorNode::DIVIDE},
-      {OP_PERCENT, BinaryOperatorNode::REMAINDER}
-  };
-  binaryOpNodeMap = std::make_unique<BinaryOpMap>(std::move(binary));
+struct BinaryOperatorInfo {
+  int precedence;
+  bool rightAssociative;
+  BinaryOperatorNode::BinaryOperator op;
+};
+
+struct UnaryOperatorInfo {
+  bool isUnary;
+  UnaryOperatorNode::UnaryOperator op;
+};
+
+const int ASSIGNMENT_LEVEL = 1;
+const int OR_LEVEL = 2;
+const int AND_LEVEL = 3;
+const int PREDICATE_LEVEL = 4;
+const int ADDITION_LEVEL = 5;
+const int MULTIPLICATION_LEVEL = 6;
+
+constexpr std::array<BinaryOperatorInfo, OP_COUNT> makeBinaryOperatorTable() {
+  std::array<BinaryOperatorInfo, OP_COUNT> table{};
+  table[OP_EQUALS] = {ASSIGNMENT_LEVEL, true, BinaryOperatorNode::ASSIGN};
+  table[OP_PLUS_EQUALS] = {ASSIGNMENT_LEVEL, true, BinaryOperatorNode::ADD_ASSIGN};
+  table[OP_MINUS_EQUALS] = {ASSIGNMENT_LEVEL, true, BinaryOperatorNode::SUBTRACT_ASSIGN};
+  table[OP_ASTERISK_EQUALS] = {ASSIGNMENT_LEVEL, true, BinaryOperatorNode::MULTIPLY_ASSIGN};
+  table[OP_SLASH_EQUALS] = {ASSIGNMENT_LEVEL, true, BinaryOperatorNode::DIVIDE_ASSIGN};
+  table[OP_PERCENT_EQUALS] = {ASSIGNMENT_LEVEL, true, BinaryOperatorNode::REMAINDER_ASSIGN};
+  table[OP_OR_EQUALS] = {ASSIGNMENT_LEVEL, true, BinaryOperatorNode::OR_ASSIGN};
+  table[OP_AND_EQUALS] = {ASSIGNMENT_LEVEL, true, BinaryOperatorNode::AND_ASSIGN};
+  table[OP_OR] = {OR_LEVEL, false, BinaryOperatorNode::OR};
+  table[OP_AND] = {AND_LEVEL, false, BinaryOperatorNode::AND};
+  table[OP_IS_EQUAL_TO] = {PREDICATE_LEVEL, false, BinaryOperatorNode::EQUAL};
+  table[OP_IS_LESS_THAN] = {PREDICATE_LEVEL, false, BinaryOperatorNode::LESS};
+  table[OP_IS_GREATER_THAN] = {PREDICATE_LEVEL, false, BinaryOperatorNode::GREATER};
+  table[OP_IS_LESS_EQUAL] = {PREDICATE_LEVEL, false, BinaryOperatorNode::LESS_EQUAL};
+  table[OP_IS_GREATER_EQUAL] = {PREDICATE_LEVEL, false, BinaryOperatorNode::GREATER_EQUAL};
+  table[OP_IS_DIFFERENT] = {PREDICATE_LEVEL, false, BinaryOperatorNode::DIFFERENT};
+  table[OP_PLUS] = {ADDITION_LEVEL, false, BinaryOperatorNode::ADD};
+  table[OP_MINUS] = {ADDITION_LEVEL, false, BinaryOperatorNode::SUBTRACT};
+  table[OP_ASTERISK] = {MULTIPLICATION_LEVEL, false, BinaryOperatorNode::MULTIPLY};
+  table[OP_SLASH] = {MULTIPLICATION_LEVEL, false, BinaryOperatorNode::DIVIDE};
+  table[OP_PERCENT] = {MULTIPLICATION_LEVEL, false, BinaryOperatorNode::REMAINDER};
+  return table;
+}
+
+constexpr std::array<UnaryOperatorInfo, OP_COUNT> makeUnaryOperatorTable() {
+  std::array<UnaryOperatorInfo, OP_COUNT> table{};
+  table[OP_PLUS] = {true, UnaryOperatorNode::PLUS};
+  table[OP_MINUS] = {true, UnaryOperatorNode::MINUS};
+  table[OP_NOT] = {true, UnaryOperatorNode::NOT};
+  return table;
+}
+
+constexpr auto binaryOperatorTable = makeBinaryOperatorTable();
+constexpr auto unaryOperatorTable = makeUnaryOperatorTable();
 }
 
 std::unique_ptr<ExpressionNode> ExpressionParser::parse(TokenIter& iter) {
-  return parseAssignmentLevel(iter);
-}
-
-std::unique_ptr<ExpressionNode> ExpressionParser::parseAssignmentLevel(TokenIter& iter) {
-  auto node = parseOrLevel(iter);
-  if (isOperator(*iter) && isOnLevel(*assignmentOpTokens, *iter)) {
-    auto op = binaryOpNodeMap->at(std::dynamic_pointer_cast<OperatorToken>(*iter)->getOperator());
-    node = std::make_unique<BinaryOperatorNode>(op, std::move(node), parseAssignmentLevel(++iter));
-  }
-  return node;
+  return parseBinaryOperators(iter, ASSIGNMENT_LEVEL);
 }
 
-std::unique_ptr<ExpressionNode> ExpressionParser::parseOrLevel(TokenIter& iter) {
-  auto node = parseAndLevel(iter);
-  while (isOperator(*iter) && getOperator(*iter) == OP_OR) {
-    node = std::make_unique<BinaryOperatorNode>(BinaryOperatorNode::OR, std::move(node), parseAndLevel(++iter));
-  }
-  return node;
-}
-
-std::unique_ptr<ExpressionNode> ExpressionParser::parseAndLevel(TokenIter& iter) {
-  auto node = parsePredicateLevel(iter);
-  while (isOperator(*iter) && getOperator(*iter) == OP_AND) {
-    node = std::make_unique<BinaryOperatorNode>(BinaryOperatorNode::AND, std::move(node), parsePredicateLevel(++iter));
-  }
-  return node;
-}
-
-std::unique_ptr<ExpressionNode> ExpressionParser::parsePredicateLevel(TokenIter& iter) {
-  auto node = parseAdditionLevel(iter);
-  while (isOperator(*iter) && isOnLevel(*predicateTokens, *iter)) {
-    auto op = binaryOpNodeMap->at(getOperator(*iter));
-    node = std::make_unique<BinaryOperatorNode>(op, std::move(node), parseAdditionLevel(++iter));
-  }
-  return node;
-}
-
-std::unique_ptr<ExpressionNode> ExpressionParser::parseAdditionLevel(TokenIter& iter) {
-  auto node = parseMultiplicationLevel(iter);
-  while (isOperator(*iter) && isOnLevel(*additionOpTokens, *iter)) {
-    auto op = binaryOpNodeMap->at(getOperator(*iter));
-    node = std::make_unique<BinaryOperatorNode>(op, std::move(node), parseMultiplicationLevel(++iter));
-  }
-  return node;
-}
-
-std::unique_ptr<ExpressionNode> ExpressionParser::parseMultiplicationLevel(TokenIter& iter) {
-  auto node = parseUnaryOperatorsLevel(iter);
-  while (isOperator(*iter) && isOnLevel(*multiplicationOpTokens, *iter)) {
-    auto op = binaryOpNodeMap->at(getOperator(*iter));
-    node = std::make_unique<BinaryOperatorNode>(op, std::move(node), parseUnaryOperatorsLevel(++iter));
+std::unique_ptr<ExpressionNode> ExpressionParser::parseBinaryOperators(TokenIter& iter, int minPrecedence) {
+  auto node = parseUnaryOperators(iter);
+  while (isOperator(*iter)) {
+    const auto& info = binaryOperatorTable[getOperator(*iter)];
+    if (info.precedence < minPrecedence || info.precedence == 0) {
+      break;
+    }
+    auto rhs = parseBinaryOperators(++iter, info.rightAssociative ? info.precedence : info.precedence + 1);
+    node = std::make_unique<BinaryOperatorNode>(info.op, std::move(node), std::move(rhs));
   }
   return node;
 }
 
-std::unique_ptr<ExpressionNode> ExpressionParser::parseUnaryOperatorsLevel(TokenIter& iter) {
-  if (isOperator(*iter) && isOnLevel(*unaryOpTokens, *iter)) {
-    auto op = unaryOpNodeMap->at(getOperator(*iter));
-    return std::make_unique<UnaryOperatorNode>(op, parseUnaryOperatorsLevel(++iter));
+std::unique_ptr<ExpressionNode> ExpressionParser::parseUnaryOperators(TokenIter& iter) {
+  if (isOperator(*iter)) {
+    const auto& info = unaryOperatorTable[getOperator(*iter)];
+    if (info.isUnary) {
+      return std::make_unique<UnaryOperatorNode>(info.op, parseUnaryOperators(++iter));
+    }
   }
-  return parseIndexOperatorLevel(iter);
+  return parseIndexOperator(iter);
 }
 
-std::unique_ptr<ExpressionNode> ExpressionParser::parseIndexOperatorLevel(TokenIter& iter) {
+std::unique_ptr<ExpressionNode> ExpressionParser::parseIndexOperator(TokenIter& iter) {
   auto node = parseOperand(iter);
-  while (isOperator(*iter) && getOperator(*iter) == OP_OPENING_SQUARE) {
+  while (isOperator(*iter, OP_OPENING_SQUARE)) {
     ++iter;
-    node = std::make_unique<BinaryOperatorNode>(BinaryOperatorNode::INDEX, std::move(node), parseAssignmentLevel(iter));
-    if (!isOperator(*iter) || getOperator(*iter) != OP_CLOSING_SQUARE) {
+    node = std::make_unique<BinaryOperatorNode>(BinaryOperatorNode::INDEX, std::move(node), parse(iter));
+    if (!isOperator(*iter, OP_CLOSING_SQUARE)) {
       throw SyntaxError((*iter)->getLocation(), "expected closing square bracket");
     }
     ++iter;
@@ -181,16 +113,16 @@ std::unique_ptr<ExpressionNode> ExpressionParser::parseOperand(TokenIter& iter)
       return std::make_unique<StringValueNode>(std::dynamic_pointer_cast<StringToken>(*(iter++))->getValue());
     case Token::IDENTIFIER: {
       auto name = std::dynamic_pointer_cast<IdentifierToken>(*(iter++))->getName();
-      if ((*iter)->getType() == Token::OPERATOR && getOperator(*iter) == OP_OPENING_ROUND) {
+      if (isOperator(*iter, OP_OPENING_ROUND)) {
         std::vector<std::unique_ptr<ExpressionNode>> arguments;
         ++iter;
-        if ((*iter)->getType() != Token::OPERATOR || getOperator(*iter) != OP_CLOSING_ROUND) {
-          arguments.emplace_back(parseAssignmentLevel(iter));
-          while ((*iter)->getType() == Token::OPERATOR && getOperator(*iter) == OP_COMMA) {
-            arguments.emplace_back(parseAssignmentLevel(++iter));
+        if (!isOperator(*iter, OP_CLOSING_ROUND)) {
+          arguments.emplace_back(parse(iter));
+          while (isOperator(*iter, OP_COMMA)) {
+            arguments.emplace_back(parse(++iter));
           }
         }
-        if ((*iter)->getType() != Token::OPERATOR || getOperator(*iter) != OP_CLOSING_ROUND) {
+        if (!isOperator(*iter, OP_CLOSING_ROUND)) {
           throw SyntaxError((*iter)->getLocation(), "expected closing parenthesis or comma");
         }
         ++iter;
@@ -198,18 +130,44 @@ std::unique_ptr<ExpressionNode> ExpressionParser::parseOperand(TokenIter& iter)
       }
       return std::make_unique<VariableNode>(name);
     }
+    case Token::KEYWORD:
+      if (std::static_pointer_cast<KeywordToken>(*iter)->getKeyword() == KEYWORD_SPAWN) {
+        auto location = (*iter)->getLocation();
+        node = parseOperand(++iter);
+        if (node->getType() != Node::FUNCTION_CALL) {
+          throw SyntaxError(location, "expected function call after spawn");
+        }
+        return std::make_unique<SpawnNode>(
+            std::unique_ptr<FunctionCallNode>(static_cast<FunctionCallNode*>(node.release())));
+      }
+      if (std::static_pointer_cast<KeywordToken>(*iter)->getKeyword() == KEYWORD_AWAIT) {
+        return std::make_unique<AwaitNode>(parseIndexOperator(++iter));
+      }
+      if (std::static_pointer_cast<KeywordToken>(*iter)->getKeyword() == KEYWORD_CHANNEL) {
+        int type = Parser::parseType(iter);
+        if (!isOperator(*iter, OP_OPENING_ROUND)) {
+          throw SyntaxError((*iter)->getLocation(), "expected channel capacity");
+        }
+        node = parse(++iter);
+        if (!isOperator(*iter, OP_CLOSING_ROUND)) {
+          throw SyntaxError((*iter)->getLocation(), "expected closing parenthesis");
+        }
+        ++iter;
+        return std::make_unique<ChannelNode>(type, std::move(node));
+      }
+      throw SyntaxError((*iter)->getLocation(), "expected open parenthesis, unary operator or operand");
     case Token::OPERATOR:
       if (getOperator(*iter) == OP_OPENING_SQUARE) {
         ++iter;
         std::vector<std::unique_ptr<ExpressionNode>> elements;
-        if ((*iter)->getType() == Token::OPERATOR && getOperator(*iter) == OP_CLOSING_SQUARE) {
+        if (isOperator(*iter, OP_CLOSING_SQUARE)) {
           return std::make_unique<ListValueNode>(std::move(elements));
         }
-        elements.emplace_back(parseAssignmentLevel(iter));
-        while ((*iter)->getType() == Token::OPERATOR && getOperator(*iter) == OP_COMMA) {
-          elements.emplace_back(parseAssignmentLevel(++iter));
+        elements.emplace_back(parse(iter));
+        while (isOperator(*iter, OP_COMMA)) {
+          elements.emplace_back(parse(++iter));
         }
-        if ((*iter)->getType() != Token::OPERATOR || getOperator(*iter) != OP_CLOSING_SQUARE) {
+        if (!isOperator(*iter, OP_CLOSING_SQUARE)) {
           throw SyntaxError((*iter)->getLocation(), "expected closing square bracket or comma");
         }
         ++iter;
@@ -218,8 +176,8 @@ std::unique_ptr<ExpressionNode> ExpressionParser::parseOperand(TokenIter& iter)
       if (getOperator(*iter) != OP_OPENING_ROUND) {
         throw SyntaxError((*iter)->getLocation(), "expected open parenthesis, unary operator or operand");
       }
-      node = parseAssignmentLevel(++iter);
-      if (!isOperator(*iter) || getOperator(*iter) != OP_CLOSING_ROUND) {
+      node = parse(++iter);
+      if (!isOperator(*iter, OP_CLOSING_ROUND)) {
         throw SyntaxError((*iter)->getLocation(), "expected binary operator or closing parenthesis");
       }
       ++iter;
@@ -233,10 +191,10 @@ bool ExpressionParser::isOperator(const std::shared_ptr<Token>& token) {
   return token->getType() == Token::OPERATOR;
 }
 
-bool ExpressionParser::isOnLevel(const std::vector<OperatorTokenType>& opList, const std::shared_ptr<Token>& token) {
-  return std::count(opList.begin(), opList.end(), getOperator(token)) == 1;
+bool ExpressionParser::isOperator(const std::shared_ptr<Token>& token, OperatorTokenType op) {
+  return isOperator(token) && getOperator(token) == op;
 }
 
 OperatorTokenType ExpressionParser::getOperator(const std::shared_ptr<Token>& token) {
-  return std::dynamic_pointer_cast<OperatorToken>(token)->getOperator();
+  return std::static_pointer_cast<OperatorToken>(token)->getOperator();
 }
@@ -10,21 +10,15 @@
 
 class ExpressionParser {
  public:
-  static void initializeData();
   static std::unique_ptr<ExpressionNode> parse(TokenIter& iter);
 
  private:
-  static std::unique_ptr<ExpressionNode> parseAssignmentLevel(TokenIter& iter);
-  static std::unique_ptr<ExpressionNode> parseOrLevel(TokenIter& iter);
-  static std::unique_ptr<ExpressionNode> parseAndLevel(TokenIter& iter);
-  static std::unique_ptr<ExpressionNode> parsePredicateLevel(TokenIter& iter);
-  static std::unique_ptr<ExpressionNode> parseAdditionLevel(TokenIter& iter);
-  static std::unique_ptr<ExpressionNode> parseMultiplicationLevel(TokenIter& iter);
-  static std::unique_ptr<ExpressionNode> parseUnaryOperatorsLevel(TokenIter& iter);
-  static std::unique_ptr<ExpressionNode> parseIndexOperatorLevel(TokenIter& iter);
+  static std::unique_ptr<ExpressionNode> parseBinaryOperators(TokenIter& iter, int minPrecedence);
+  static std::unique_ptr<ExpressionNode> parseUnaryOperators(TokenIter& iter);
+  static std::unique_ptr<ExpressionNode> parseIndexOperator(TokenIter& iter);
   static std::unique_ptr<ExpressionNode> parseOperand(TokenIter& iter);
   static bool isOperator(const std::shared_ptr<Token>& token);
-  static bool isOnLevel(const std::vector<OperatorTokenType>& opList, const std::shared_ptr<Token>& token);
+  static bool isOperator(const std::shared_ptr<Token>& token, OperatorTokenType op);
   static OperatorTokenType getOperator(const std::shared_ptr<Token>& token);
 };
 
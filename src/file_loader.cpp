@@ -0,0 +1,93 @@
+#include "file_loader.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <exception>
+#include <system_error>
+#include <thread>
+
+#include "runtime_error.h"
+
+namespace {
+// reads wait on the disk rather than the CPU, so the number of readers does not follow the core count
+const size_t READERS = 8;
+}
+
+std::string FileLoader::read(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw RuntimeError("can not open file " + path);
+  }
+  struct stat status{};
+  if (fstat(fd, &status) < 0 || !S_ISREG(status.st_mode)) {
+    close(fd);
+    throw RuntimeError("can not read file " + path);
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+  std::string content(status.st_size, '\0');
+  size_t done = 0;
+  while (done < content.size()) {
+    ssize_t count = pread(fd, &content[done], content.size() - done, static_cast<off_t>(done));
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count < 0) {
+      close(fd);
+      throw RuntimeError("can not read file " + path);
+    }
+    if (count == 0) {
+      break;
+    }
+    done += count;
+  }
+  close(fd);
+  // the file may have been truncated since fstat
+  content.resize(done);
+  return content;
+}
+
+std::vector<std::string> FileLoader::readAll(const std::vector<std::string>& paths) {
+  std::vector<std::string> contents(paths.size());
+  std::vector<std::exception_ptr> errors(paths.size());
+  std::atomic<size_t> next(0);
+  auto reader = [&]() {
+    for (size_t i = next++; i < paths.size(); i = next++) {
+      try {
+        contents[i] = read(paths[i]);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+  // own threads instead of the pool, which has one worker per spare core and runs nested loops serially
+  std::vector<std::thread> readers;
+  try {
+    for (size_t i = 1; i < std::min(READERS, paths.size()); ++i) {
+      readers.emplace_back(reader);
+    }
+  } catch (const std::system_error&) {
+    // out of threads: the readers already running and this thread still get through every path
+  } catch (...) {
+    next = paths.size();
+    for (auto& thread : readers) {
+      thread.join();
+    }
+    throw;
+  }
+  reader();
+  for (auto& thread : readers) {
+    thread.join();
+  }
+  // every file is attempted, and the error reported is the one of the first failing path, not the first to fail
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+  return contents;
+}
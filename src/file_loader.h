@@ -0,0 +1,14 @@
+#ifndef PROG_LANG_FILE_LOADER_H
+#define PROG_LANG_FILE_LOADER_H
+
+#include <string>
+#include <vector>
+
+// Reads whole files into memory; batches are spread over a fixed number of reader threads so that reads overlap
+class FileLoader {
+ public:
+  static std::string read(const std::string& path);
+  static std::vector<std::string> readAll(const std::vector<std::string>& paths);
+};
+
+#endif //PROG_LANG_FILE_LOADER_H
@@ -0,0 +1,61 @@
+#include "file_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "output_buffer.h"
+#include "runtime_error.h"
+
+namespace {
+const size_t BUFFER_SIZE = 1 << 18;
+}
+
+FileWriter::FileWriter(const std::string& path) : path(path) {
+  fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    throw RuntimeError("can not open file " + path + " for writing");
+  }
+  buffer = std::make_unique<OutputBuffer>(fd, BUFFER_SIZE, false);
+}
+
+// errors can not be reported from here, scripts that need to know call close
+FileWriter::~FileWriter() {
+  if (fd >= 0) {
+    buffer.reset();
+    ::close(fd);
+  }
+}
+
+void FileWriter::write(const char* data, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex);
+  append(data, size);
+}
+
+void FileWriter::writeLine(const char* data, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex);
+  append(data, size);
+  append("\n", 1);
+}
+
+void FileWriter::close() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (fd < 0) {
+    return;
+  }
+  bool flushed = buffer->pubsync() == 0;
+  buffer.reset();
+  bool closed = ::close(fd) == 0;
+  fd = -1;
+  if (!flushed || !closed) {
+    throw RuntimeError("can not write file " + path);
+  }
+}
+
+void FileWriter::append(const char* data, size_t size) {
+  if (fd < 0) {
+    throw RuntimeError("write to a closed file " + path);
+  }
+  if (buffer->sputn(data, static_cast<std::streamsize>(size)) != static_cast<std::streamsize>(size)) {
+    throw RuntimeError("can not write file " + path);
+  }
+}
@@ -0,0 +1,33 @@
+#ifndef PROG_LANG_FILE_WRITER_H
+#define PROG_LANG_FILE_WRITER_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+class OutputBuffer;
+
+// Output file opened by a script. Writes are collected in a large buffer; whatever is left in it is written when the
+// writer is closed or its last reference goes away
+class FileWriter {
+ public:
+  explicit FileWriter(const std::string& path);
+  FileWriter(const FileWriter&) = delete;
+  FileWriter& operator=(const FileWriter&) = delete;
+  ~FileWriter();
+
+  void write(const char* data, size_t size);
+  // the text and its newline are written under one lock, so lines from concurrent tasks are not interleaved
+  void writeLine(const char* data, size_t size);
+  void close();
+
+ private:
+  void append(const char* data, size_t size);
+
+  std::string path;
+  int fd;
+  std::unique_ptr<OutputBuffer> buffer;
+  std::mutex mutex;
+};
+
+#endif //PROG_LANG_FILE_WRITER_H
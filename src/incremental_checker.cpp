@@ -0,0 +1,128 @@
+#include "incremental_checker.h"
+
+#include <cctype>
+
+#include "lexer.h"
+#include "parser.h"
+#include "semantic_analyzer.h"
+
+void IncrementalChecker::check(const std::string& fileName) {
+  context.getModuleLoader().setMainFile(fileName);
+  check(Lexer::readSourceLines(fileName));
+}
+
+void IncrementalChecker::check(const std::vector<std::string>& lines) {
+  std::vector<std::shared_ptr<Chunk>> current;
+  std::set<Chunk*> taken;
+  for (const auto& range : splitChunks(lines)) {
+    current.push_back(getChunk(lines, range.first, range.second, taken));
+  }
+  analyze(current);
+  cache.clear();
+  for (const auto& chunk : current) {
+    cache.emplace(chunk->hash, chunk);
+  }
+  previous = std::move(current);
+}
+
+std::vector<std::pair<int, int>> IncrementalChecker::splitChunks(const std::vector<std::string>& lines) {
+  std::vector<std::pair<int, int>> ranges;
+  int baseIndent = -1;
+  int n = static_cast<int>(lines.size());
+  for (int i = 0; i < n; ++i) {
+    int indent = getIndent(lines[i]);
+    if (indent == static_cast<int>(lines[i].size())) {
+      continue;
+    }
+    if (baseIndent == -1) {
+      baseIndent = indent;
+    }
+    if (indent < baseIndent) {
+      // the parser rejects this file; check it as a single chunk so that the error is reported as usual
+      return {std::make_pair(0, n)};
+    }
+    if (indent == baseIndent && (ranges.empty() || !isElseLine(lines[i]))) {
+      ranges.emplace_back(ranges.empty() ? 0 : i, 0);
+    }
+  }
+  if (ranges.empty()) {
+    return {std::make_pair(0, n)};
+  }
+  for (size_t i = 0; i + 1 < ranges.size(); ++i) {
+    ranges[i].second = ranges[i + 1].first - ranges[i].first;
+  }
+  ranges.back().second = n - ranges.back().first;
+  return ranges;
+}
+
+int IncrementalChecker::getIndent(const std::string& line) {
+  int indent = 0;
+  while (indent < static_cast<int>(line.size()) && std::isspace(line[indent])) {
+    ++indent;
+  }
+  return indent;
+}
+
+bool IncrementalChecker::isElseLine(const std::string& line) {
+  auto pos = static_cast<size_t>(getIndent(line));
+  if (line.compare(pos, 4, "else") != 0) {
+    return false;
+  }
+  pos += 4;
+  return pos == line.size() || (!std::isalnum(line[pos]) && line[pos] != '_');
+}
+
+std::shared_ptr<IncrementalChecker::Chunk>
+IncrementalChecker::getChunk(const std::vector<std::string>& lines, int first, int count, std::set<Chunk*>& taken) {
+  std::vector<std::string> chunkLines(lines.begin() + first, lines.begin() + first + count);
+  std::string text;
+  for (const auto& line : chunkLines) {
+    text += line;
+    text += '\n';
+  }
+  std::size_t hash = std::hash<std::string>()(text);
+  auto range = cache.equal_range(hash);
+  // a chunk repeated in the file takes a different cached copy each time, so that every occurrence keeps its own
+  // analysis state
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second->text == text && taken.insert(it->second.get()).second) {
+      return it->second;
+    }
+  }
+  auto tree = Parser::parseFile(Lexer::readLines(chunkLines, first + 1));
+  return std::make_shared<Chunk>(Chunk{count, hash, std::move(text), std::move(tree), false, {}});
+}
+
+void IncrementalChecker::analyze(const std::vector<std::shared_ptr<Chunk>>& chunks) {
+  bool unchangedPrefix = true;
+  auto& store = context.getStore();
+  SemanticAnalyzer analyzer(context);
+  store.reset();
+  store.newLevel();
+  try {
+    for (size_t i = 0; i < chunks.size(); ++i) {
+      const auto& chunk = chunks[i];
+      unchangedPrefix = unchangedPrefix && i < previous.size() && previous[i] == chunk;
+      std::vector<int> modules;
+      for (const auto& node : chunk->tree->getContent()) {
+        if (unchangedPrefix && chunk->verified && node->getType() == Node::FUNCTION_DEFINITION) {
+          analyzer.registerFunction(dynamic_cast<FunctionDefinitionNode*>(node.get()));
+        } else {
+          analyzer.analyze(node.get());
+        }
+        if (node->getType() == Node::IMPORT_STATEMENT) {
+          modules.push_back(dynamic_cast<ImportNode*>(node.get())->getModule()->getId());
+        }
+      }
+      if (modules != chunk->modules) {
+        unchangedPrefix = false;
+        chunk->modules = std::move(modules);
+      }
+      chunk->verified = true;
+    }
+  } catch (...) {
+    store.reset();
+    throw;
+  }
+  store.reset();
+}
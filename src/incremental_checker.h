@@ -0,0 +1,43 @@
+#ifndef PROG_LANG_INCREMENTAL_CHECKER_H
+#define PROG_LANG_INCREMENTAL_CHECKER_H
+
+#include <memory>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "context.h"
+#include "node.h"
+
+// Reuses unchanged top-level instructions (and verified function bodies) between consecutive checks
+class IncrementalChecker {
+ public:
+  void check(const std::string& fileName);
+  void check(const std::vector<std::string>& lines);
+
+ private:
+  // shared by every check that contains the same text, so it holds nothing that depends on where the text sits;
+  // the tree keeps no line numbers, and a syntax error is only found while parsing at the current position
+  struct Chunk {
+    int lineCount;
+    std::size_t hash;
+    std::string text;
+    std::unique_ptr<BlockNode> tree;
+    bool verified;
+    std::vector<int> modules;
+  };
+
+  static std::vector<std::pair<int, int>> splitChunks(const std::vector<std::string>& lines);
+  static int getIndent(const std::string& line);
+  static bool isElseLine(const std::string& line);
+  std::shared_ptr<Chunk> getChunk(const std::vector<std::string>& lines, int first, int count,
+                                  std::set<Chunk*>& taken);
+  void analyze(const std::vector<std::shared_ptr<Chunk>>& chunks);
+
+  Context context;
+  std::unordered_multimap<std::size_t, std::shared_ptr<Chunk>> cache;
+  std::vector<std::shared_ptr<Chunk>> previous;
+};
+
+#endif //PROG_LANG_INCREMENTAL_CHECKER_H
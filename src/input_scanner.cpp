@@ -0,0 +1,106 @@
+#include "input_scanner.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace {
+bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+}
+
+InputScanner::InputScanner(std::istream& input, std::ostream* prompt) : input(input), prompt(prompt), position(0) {}
+
+std::string InputScanner::nextToken() {
+  if (!skipWhitespace()) {
+    return "";
+  }
+  size_t end = findTokenEnd();
+  std::string token = buffer.substr(position, end - position);
+  position = end;
+  return token;
+}
+
+bool InputScanner::nextNumber(double& value) {
+  if (!skipWhitespace()) {
+    return false;
+  }
+  size_t end = findTokenEnd();
+  const char* first = buffer.data() + position;
+  if (*first == '+' && end - position > 1 && first[1] != '-') {
+    ++first;
+  }
+  auto result = std::from_chars(first, buffer.data() + end, value);
+  if (result.ec != std::errc() || result.ptr == first) {
+    return false;
+  }
+  position = result.ptr - buffer.data();
+  return true;
+}
+
+bool InputScanner::nextLine(std::string& line) {
+  line.clear();
+  while (true) {
+    const char* begin = buffer.data() + position;
+    const char* end = buffer.data() + buffer.size();
+    auto newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+    if (newline != nullptr) {
+      line.append(begin, newline);
+      position = newline - buffer.data() + 1;
+      return true;
+    }
+    line.append(begin, end);
+    position = buffer.size();
+    if (!fill()) {
+      return !line.empty();
+    }
+  }
+}
+
+// takes what the stream already has buffered, so that interactive input is not blocked waiting for a full block
+bool InputScanner::fill() {
+  if (position > 0 && position >= buffer.size() / 2) {
+    buffer.erase(0, position);
+    position = 0;
+  }
+  auto streamBuffer = input.rdbuf();
+  // output printed before a read has to be visible while the script waits, but input that is already buffered does
+  // not wait, so piped input keeps the output in large blocks
+  if (prompt != nullptr && streamBuffer != nullptr && streamBuffer->in_avail() <= 0) {
+    prompt->flush();
+  }
+  if (streamBuffer == nullptr || streamBuffer->sgetc() == std::char_traits<char>::eof()) {
+    return false;
+  }
+  auto available = std::max<std::streamsize>(streamBuffer->in_avail(), 1);
+  size_t size = buffer.size();
+  buffer.resize(size + available);
+  auto count = streamBuffer->sgetn(&buffer[size], available);
+  buffer.resize(size + count);
+  return count > 0;
+}
+
+bool InputScanner::skipWhitespace() {
+  while (true) {
+    while (position < buffer.size() && isSpace(buffer[position])) {
+      ++position;
+    }
+    if (position < buffer.size()) {
+      return true;
+    }
+    if (!fill()) {
+      return false;
+    }
+  }
+}
+
+size_t InputScanner::findTokenEnd() {
+  size_t offset = 0;
+  while (true) {
+    while (position + offset < buffer.size() && !isSpace(buffer[position + offset])) {
+      ++offset;
+    }
+    if (position + offset < buffer.size() || !fill()) {
+      return position + offset;
+    }
+  }
+}
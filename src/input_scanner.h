@@ -0,0 +1,31 @@
+#ifndef PROG_LANG_INPUT_SCANNER_H
+#define PROG_LANG_INPUT_SCANNER_H
+
+#include <iostream>
+#include <string>
+
+// Whitespace separated tokens read from a stream in blocks. It takes over the stream: input it buffered is not
+// visible to other readers any more
+class InputScanner {
+ public:
+  // prompt, when given, is flushed whenever the scanner has to wait for more input
+  explicit InputScanner(std::istream& input, std::ostream* prompt = nullptr);
+  // empty at the end of the input
+  std::string nextToken();
+  // consumes only the characters of the number, like operator>> does
+  bool nextNumber(double& value);
+  // the rest of the current line without its newline; false at the end of the input
+  bool nextLine(std::string& line);
+
+ private:
+  bool fill();
+  bool skipWhitespace();
+  size_t findTokenEnd();
+
+  std::istream& input;
+  std::ostream* prompt;
+  std::string buffer;
+  size_t position;
+};
+
+#endif //PROG_LANG_INPUT_SCANNER_H
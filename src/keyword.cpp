@@ -1,14 +1,11 @@
 #include "keyword.h"
 
-#include <memory>
-
 namespace {
 typedef std::map<std::string, Keyword> Map;
-std::unique_ptr<Map> keywordMapping;
 }
 
-void initializeKeywordMapping() {
-  Map mp{
+const Map& keywordMap() {
+  static const Map mp{
       {"if", KEYWORD_IF},
       {"else", KEYWORD_ELSE},
       {"while", KEYWORD_WHILE},
@@ -22,11 +19,13 @@ void initializeKeywordMapping() {
       {"def", KEYWORD_DEF},
       {"return", KEYWORD_RETURN},
       {"print", KEYWORD_PRINT},
-      {"read", KEYWORD_READ}
+      {"read", KEYWORD_READ},
+      {"import", KEYWORD_IMPORT},
+      {"parallel", KEYWORD_PARALLEL},
+      {"spawn", KEYWORD_SPAWN},
+      {"await", KEYWORD_AWAIT},
+      {"task", KEYWORD_TASK},
+      {"channel", KEYWORD_CHANNEL}
   };
-  keywordMapping = std::make_unique<Map>(std::move(mp));
-}
-
-const Map& keywordMap() {
-  return *keywordMapping;
+  return mp;
 }
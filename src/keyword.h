@@ -18,10 +18,15 @@ enum Keyword {
   KEYWORD_DEF,
   KEYWORD_RETURN,
   KEYWORD_PRINT,
-  KEYWORD_READ
+  KEYWORD_READ,
+  KEYWORD_IMPORT,
+  KEYWORD_PARALLEL,
+  KEYWORD_SPAWN,
+  KEYWORD_AWAIT,
+  KEYWORD_TASK,
+  KEYWORD_CHANNEL
 };
 
-void initializeKeywordMapping();
 const std::map<std::string, Keyword>& keywordMap();
 
 #endif //PROG_LANG_KEYWORD_H
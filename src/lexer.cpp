@@ -3,19 +3,36 @@
 #include <fstream>
 
 #include "keyword.h"
+#include "number_format.h"
 #include "operator.h"
 #include "syntax_error.h"
 
 TokenList Lexer::readfile(const std::string& fileName) {
+  return readLines(readSourceLines(fileName));
+}
+
+std::vector<std::string> Lexer::readSourceLines(const std::string& fileName) {
   std::ifstream input(fileName);
+  return readSourceLines(input);
+}
+
+std::vector<std::string> Lexer::readSourceLines(std::istream& input) {
   std::string buffer;
-  TokenList tokenList;
-  int currentLine = 1;
-  // TODO: check what happens with empty lines
+  std::vector<std::string> lines;
   while (std::getline(input, buffer)) {
     if (!buffer.empty() && buffer.back() == '\r') {
       buffer.pop_back();
     }
+    lines.push_back(buffer);
+  }
+  return lines;
+}
+
+TokenList Lexer::readLines(const std::vector<std::string>& lines, int firstLine) {
+  TokenList tokenList;
+  int currentLine = firstLine;
+  // TODO: check what happens with empty lines
+  for (const auto& buffer : lines) {
     TokenList line = readLine(currentLine, buffer);
     tokenList.insert(tokenList.end(), line.begin(), line.end());
     ++currentLine;
@@ -37,7 +54,7 @@ TokenList Lexer::readLine(int lineIndex, const std::string& buffer) {
     std::string s;
     double n;
     if (std::isdigit(*it)) {
-      n = getNumber(buffer, it);
+      n = getNumber(lineIndex, buffer, it);
       if (it != buffer.end() && (std::isalpha(*it) || *it == '_')) {
         throw SyntaxError(lineIndex, static_cast<int>(it - buffer.begin() + 1),
             "unexpected symbol in numeric value");
@@ -92,19 +109,22 @@ std::string Lexer::getWord(const std::string& buffer, std::string::const_iterato
   return ans;
 }
 
-double Lexer::getNumber(const std::string& buffer, std::string::const_iterator& it) {
+double Lexer::getNumber(int lineIndex, const std::string& buffer, std::string::const_iterator& it) {
   // TODO: scientific notation?
-  double ans = 0;
+  auto first = it;
   while (it != buffer.end() && std::isdigit(*it)) {
-    ans = ans * 10 + *(it++) - '0';
+    ++it;
   }
   if (it != buffer.end() && *it == '.') {
     ++it;
-    double pw = 1.0;
     while (it != buffer.end() && std::isdigit(*it)) {
-      ans += (pw /= 10) * (*(it++) - '0');
+      ++it;
     }
   }
+  double ans;
+  if (!NumberFormat::parse(&*first, &*first + (it - first), ans)) {
+    throw SyntaxError(lineIndex, static_cast<int>(first - buffer.begin() + 1), "numeric value out of range");
+  }
   return ans;
 }
 
@@ -120,7 +140,8 @@ std::string Lexer::getString(const std::string& buffer, std::string::const_itera
 
 std::string Lexer::getOperator(const std::string& buffer, std::string::const_iterator& it) {
   std::string ans;
-  while (it != buffer.end() && !std::isalnum(*it) && *it != '_' && !std::isspace(*it)) {
+  while (it != buffer.end() && ans.size() < maxOperatorLength() && !std::isalnum(*it) && *it != '_' &&
+      !std::isspace(*it)) {
     ans += *(it++);
   }
   while (!ans.empty() && operatorTokenMap().count(ans) == 0) {
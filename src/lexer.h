@@ -1,6 +1,7 @@
 #ifndef PROG_LANG_LEXER_H
 #define PROG_LANG_LEXER_H
 
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -9,12 +10,15 @@
 class Lexer {
  public:
   static TokenList readfile(const std::string& fileName);
+  static std::vector<std::string> readSourceLines(const std::string& fileName);
+  static std::vector<std::string> readSourceLines(std::istream& input);
+  static TokenList readLines(const std::vector<std::string>& lines, int firstLine = 1);
 
  private:
   static TokenList readLine(int lineIndex, const std::string& buffer);
   static int skipWhitespace(const std::string& buffer, std::string::const_iterator& it);
   static std::string getWord(const std::string& buffer, std::string::const_iterator& it);
-  static double getNumber(const std::string& buffer, std::string::const_iterator& it);
+  static double getNumber(int lineIndex, const std::string& buffer, std::string::const_iterator& it);
   static std::string getString(const std::string& buffer, std::string::const_iterator& it);
   static std::string getOperator(const std::string& buffer, std::string::const_iterator& it);
 };
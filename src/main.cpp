@@ -1,38 +1,214 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
 
 #include "error.h"
-#include "expression_parser.h"
-#include "lexer.h"
-#include "parser.h"
-#include "semantic_analyzer.h"
-#include "vm.h"
+#include "incremental_checker.h"
+#include "output_buffer.h"
+#include "program.h"
+#include "server.h"
 
-void initialize() {
-  initializeKeywordMapping();
-  initializeOperatorTokenMapping();
-  ExpressionParser::initializeData();
+void runCheckMode() {
+  std::map<std::string, IncrementalChecker> checkers;
+  std::string sourceFile;
+  while (std::getline(std::cin, sourceFile)) {
+    if (!std::ifstream(sourceFile)) {
+      std::cout << "Error: can not open source file." << std::endl;
+      continue;
+    }
+    try {
+      checkers[sourceFile].check(sourceFile);
+      std::cout << "OK" << std::endl;
+    } catch (Error& e) {
+      std::cout << e.toString() << std::endl;
+    }
+  }
+}
+
+std::vector<std::string> listBatchInputs(const std::string& inputs) {
+  std::vector<std::string> files;
+  if (std::filesystem::is_directory(inputs)) {
+    for (const auto& entry : std::filesystem::directory_iterator(inputs)) {
+      if (entry.is_regular_file() && entry.path().extension() != ".out") {
+        files.push_back(entry.path().string());
+      }
+    }
+    std::sort(files.begin(), files.end());
+  } else {
+    std::ifstream list(inputs);
+    std::string line;
+    while (std::getline(list, line)) {
+      if (!line.empty()) {
+        files.push_back(line);
+      }
+    }
+  }
+  return files;
+}
+
+void runBatchMode(const Program& program, const std::string& inputs, const std::string& outputDir, unsigned jobs,
+                  const std::vector<std::string>& arguments) {
+  std::error_code error;
+  if (!outputDir.empty() && !std::filesystem::create_directories(outputDir, error) && error) {
+    std::cout << "Error: can not create output directory." << std::endl;
+    return;
+  }
+  auto files = listBatchInputs(inputs);
+  std::vector<std::string> status(files.size());
+  std::vector<double> times(files.size());
+  std::atomic<size_t> next(0);
+  auto worker = [&]() {
+    for (size_t i = next++; i < files.size(); i = next++) {
+      auto start = std::chrono::steady_clock::now();
+      std::ifstream input(files[i]);
+      std::ostringstream output;
+      if (!input) {
+        status[i] = "Error: can not open input file.";
+      } else {
+        try {
+          program.run(input, output, arguments);
+          status[i] = "OK";
+        } catch (Error& e) {
+          status[i] = e.toString();
+        } catch (std::exception& e) {
+          status[i] = std::string("Error: ") + e.what();
+        }
+      }
+      auto outputFile = outputDir.empty()
+                        ? files[i] + ".out"
+                        : (std::filesystem::path(outputDir) / std::filesystem::path(files[i]).filename()).string()
+                          + ".out";
+      std::ofstream file(outputFile);
+      file << output.str();
+      file.close();
+      if (!file) {
+        const char* message = "can not write output file.";
+        status[i] = status[i] == "OK" ? std::string("Error: ") + message : status[i] + "; " + message;
+      }
+      times[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+  };
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < jobs; ++i) {
+    workers.emplace_back(worker);
+  }
+  for (auto& thread : workers) {
+    thread.join();
+  }
+  double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  size_t passed = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    passed += status[i] == "OK";
+    std::cout << files[i] << "\t" << status[i] << "\t" << times[i] << " ms\n";
+  }
+  std::cout << passed << "/" << files.size() << " OK, " << total << " ms on " << jobs << " threads\n";
 }
 
 int main(int argc, char** argv) {
-  initialize();
-  if (argc < 2) {
+  std::ios::sync_with_stdio(false);
+  std::string sourceFile;
+  std::vector<std::string> arguments;
+  std::string batchInputs;
+  std::string outputDir;
+  std::string serveSocket;
+  std::string connectSocket;
+  bool forking = false;
+  std::vector<std::string> preload;
+  size_t cacheSize = 64;
+  unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+  bool lazy = false;
+  bool eachLine = false;
+  size_t outputBufferSize = 1 << 16;
+  bool lineBuffered = isatty(STDOUT_FILENO);
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (!sourceFile.empty()) {
+      arguments.push_back(arg);
+    } else if (arg == "--check") {
+      runCheckMode();
+      return 0;
+    } else if (arg == "--batch" && i + 1 < argc) {
+      batchInputs = argv[++i];
+    } else if (arg == "--output-dir" && i + 1 < argc) {
+      outputDir = argv[++i];
+    } else if (arg == "--serve" && i + 1 < argc) {
+      serveSocket = argv[++i];
+    } else if (arg == "--fork") {
+      forking = true;
+    } else if (arg == "--preload" && i + 1 < argc) {
+      preload.push_back(std::filesystem::absolute(argv[++i]).string());
+    } else if (arg == "--connect" && i + 1 < argc) {
+      connectSocket = argv[++i];
+    } else if (arg == "--cache-size" && i + 1 < argc) {
+      cacheSize = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--jobs" && i + 1 < argc) {
+      jobs = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--output-buffer" && i + 1 < argc) {
+      outputBufferSize = std::max(1, std::atoi(argv[++i]));
+      lineBuffered = false;
+    } else if (arg == "--line-buffered") {
+      lineBuffered = true;
+    } else if (arg == "--each-line") {
+      eachLine = true;
+    } else if (arg == "--lazy") {
+      lazy = true;
+    } else if (arg == "--check-all") {
+      lazy = false;
+    } else {
+      sourceFile = arg;
+    }
+  }
+  if (!serveSocket.empty()) {
+    try {
+      Server(serveSocket, jobs, cacheSize, lazy, forking, preload).run();
+    } catch (std::exception& e) {
+      std::cout << "Error: " << e.what() << "\n";
+    }
+    return 0;
+  }
+  if (sourceFile.empty()) {
     std::cout << "Please specify a source file as argument.\n";
     return 0;
   }
-  std::string sourceFile = argv[1];
+  if (!connectSocket.empty()) {
+    try {
+      Server::forward(connectSocket, std::filesystem::absolute(sourceFile).string(), arguments, std::cin, std::cout);
+    } catch (std::exception& e) {
+      std::cout << "Error: " << e.what() << "\n";
+      return 1;
+    }
+    return 0;
+  }
   if (!std::ifstream(sourceFile)) {
     std::cout << "Error: can not open source file.\n";
     return 0;
   }
+  OutputBuffer outputBuffer(STDOUT_FILENO, outputBufferSize, lineBuffered);
+  std::ostream output(&outputBuffer);
   try {
-    auto tokenList = Lexer::readfile(sourceFile);
-    auto fileTree = Parser::parseFile(tokenList);
-    SemanticAnalyzer::analyze(fileTree.get());
-    VirtualMachine::run(fileTree.get());
+    auto program = Program::compileFile(sourceFile, lazy);
+    if (!batchInputs.empty()) {
+      runBatchMode(*program, batchInputs, outputDir, jobs, arguments);
+    } else if (eachLine) {
+      program->runEachLine(std::cin, output, arguments);
+    } else {
+      program->run(std::cin, output, arguments);
+    }
   } catch (Error& e) {
-    std::cout << e.toString() << "\n";
+    output << e.toString() << "\n";
+  } catch (std::exception& e) {
+    output << "Error: " << e.what() << "\n";
   }
   return 0;
-}
\ No newline at end of file
+}
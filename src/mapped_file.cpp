@@ -0,0 +1,42 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "runtime_error.h"
+
+MappedFile::MappedFile(const std::string& path) : data(nullptr), size(0) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw RuntimeError("can not open file " + path);
+  }
+  struct stat status{};
+  if (fstat(fd, &status) < 0 || !S_ISREG(status.st_mode)) {
+    close(fd);
+    throw RuntimeError("can not read file " + path);
+  }
+  size = status.st_size;
+  // an empty file can not be mapped, it just has no data
+  if (size > 0) {
+    void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+      close(fd);
+      throw RuntimeError("can not map file " + path);
+    }
+    madvise(address, size, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(address);
+  }
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data != nullptr) {
+    munmap(const_cast<char*>(data), size);
+  }
+}
+
+const char* MappedFile::getData() const { return data; }
+
+size_t MappedFile::getSize() const { return size; }
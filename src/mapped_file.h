@@ -0,0 +1,22 @@
+#ifndef PROG_LANG_MAPPED_FILE_H
+#define PROG_LANG_MAPPED_FILE_H
+
+#include <string>
+
+// Read-only memory mapping of a whole file
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  const char* getData() const;
+  size_t getSize() const;
+
+ private:
+  const char* data;
+  size_t size;
+};
+
+#endif //PROG_LANG_MAPPED_FILE_H
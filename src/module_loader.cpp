@@ -0,0 +1,119 @@
+#include "module_loader.h"
+
+#include <fstream>
+
+#include "context.h"
+#include "lexer.h"
+#include "parser.h"
+#include "semantic_analyzer.h"
+#include "semantic_error.h"
+#include "vm.h"
+
+namespace {
+std::map<std::string, std::shared_ptr<Module>> modules;
+int moduleCount = 0;
+}
+
+Module::Module(std::string path, std::filesystem::file_time_type timestamp, std::unique_ptr<BlockNode> tree)
+    : path(std::move(path)), timestamp(timestamp), tree(std::move(tree)), id(++moduleCount), analyzing(false) {}
+
+std::string Module::getPath() const { return path; }
+
+std::string Module::getDirectory() const { return std::filesystem::path(path).parent_path().string(); }
+
+int Module::getId() const { return id; }
+
+ModuleLoader::ModuleLoader(Context& context) : context(context) {}
+
+void ModuleLoader::setMainFile(const std::string& fileName) {
+  directories.assign(1, std::filesystem::absolute(fileName).parent_path().string());
+}
+
+std::shared_ptr<Module> ModuleLoader::load(const std::string& path) {
+  std::string fullPath = resolve(path);
+  if (!std::ifstream(fullPath)) {
+    throw SemanticError("can not open module " + path);
+  }
+  std::lock_guard<std::recursive_mutex> lock(SemanticAnalyzer::getAnalysisMutex());
+  std::set<Module*> visited;
+  auto it = modules.find(fullPath);
+  if (it == modules.end() || (!it->second->analyzing && isOutdated(it->second.get(), visited))) {
+    auto timestamp = std::filesystem::last_write_time(fullPath);
+    auto tree = Parser::parseFile(Lexer::readfile(fullPath));
+    modules[fullPath] = std::make_shared<Module>(fullPath, timestamp, std::move(tree));
+  }
+  auto module = modules.at(fullPath);
+  if (!importers.empty()) {
+    importers.back()->dependencies.push_back(module);
+  }
+  return module;
+}
+
+std::shared_ptr<StackLevel> ModuleLoader::getDeclarations(Module* module) {
+  std::lock_guard<std::recursive_mutex> lock(SemanticAnalyzer::getAnalysisMutex());
+  if (module->analyzing) {
+    throw SemanticError("cyclic import of module " + module->path);
+  }
+  if (!module->declarations) {
+    auto& store = context.getStore();
+    module->analyzing = true;
+    // a failed analysis may have recorded some of them already
+    module->dependencies.clear();
+    directories.push_back(module->getDirectory());
+    importers.push_back(module);
+    try {
+      store.enterModule();
+      for (const auto& node : module->tree->getContent()) {
+        SemanticAnalyzer(context).analyze(node.get());
+      }
+      module->declarations = store.exitModule();
+    } catch (...) {
+      directories.pop_back();
+      importers.pop_back();
+      module->analyzing = false;
+      throw;
+    }
+    directories.pop_back();
+    importers.pop_back();
+    module->analyzing = false;
+  }
+  return module->declarations;
+}
+
+std::shared_ptr<StackLevel> ModuleLoader::execute(Module* module) {
+  auto& level = globals[module->getId()];
+  if (!level) {
+    auto& store = context.getStore();
+    store.enterModule();
+    for (const auto& node : module->tree->getContent()) {
+      VirtualMachine(context).run(node.get());
+    }
+    level = store.exitModule();
+  }
+  return level;
+}
+
+std::string ModuleLoader::resolve(const std::string& path) const {
+  std::filesystem::path modulePath(path);
+  if (modulePath.is_relative() && !directories.empty()) {
+    modulePath = std::filesystem::path(directories.back()) / modulePath;
+  }
+  return std::filesystem::weakly_canonical(modulePath).string();
+}
+
+bool ModuleLoader::isOutdated(Module* module, std::set<Module*>& visited) {
+  if (!visited.insert(module).second) {
+    return false;
+  }
+  if (!std::ifstream(module->path) || std::filesystem::last_write_time(module->path) != module->timestamp) {
+    return true;
+  }
+  for (const auto& weakDependency : module->dependencies) {
+    auto dependency = weakDependency.lock();
+    if (!dependency || modules.count(dependency->path) == 0 || modules.at(dependency->path) != dependency
+        || isOutdated(dependency.get(), visited)) {
+      return true;
+    }
+  }
+  return false;
+}
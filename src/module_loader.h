@@ -0,0 +1,54 @@
+#ifndef PROG_LANG_MODULE_LOADER_H
+#define PROG_LANG_MODULE_LOADER_H
+
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "node.h"
+#include "store.h"
+
+class Context;
+
+class Module {
+ public:
+  Module(std::string path, std::filesystem::file_time_type timestamp, std::unique_ptr<BlockNode> tree);
+  std::string getPath() const;
+  std::string getDirectory() const;
+  int getId() const;
+
+ private:
+  friend class ModuleLoader;
+  std::string path;
+  std::filesystem::file_time_type timestamp;
+  std::unique_ptr<BlockNode> tree;
+  // weak, so that a dependency replaced by a reload is seen as expired instead of left dangling
+  std::vector<std::weak_ptr<Module>> dependencies;
+  int id;
+  bool analyzing;
+  std::shared_ptr<StackLevel> declarations;
+};
+
+class ModuleLoader {
+ public:
+  explicit ModuleLoader(Context& context);
+  void setMainFile(const std::string& fileName);
+  std::shared_ptr<Module> load(const std::string& path);
+  std::shared_ptr<StackLevel> getDeclarations(Module* module);
+  std::shared_ptr<StackLevel> execute(Module* module);
+
+ private:
+  std::string resolve(const std::string& path) const;
+  // visited guards against the cycle that a failed cyclic import leaves among the dependencies
+  static bool isOutdated(Module* module, std::set<Module*>& visited);
+
+  Context& context;
+  std::vector<std::string> directories;
+  std::vector<Module*> importers;
+  std::map<int, std::shared_ptr<StackLevel>> globals;
+};
+
+#endif //PROG_LANG_MODULE_LOADER_H
@@ -24,6 +24,15 @@ const std::unique_ptr<ExpressionNode>& VariableDeclarationNode::getInitializer()
 
 Node::Type ExpressionNode::getType() const { return EXPRESSION; }
 
+int ExpressionNode::getResultType() const { return resultType; }
+
+Value::MemoryClass ExpressionNode::getMemoryClass() const { return memoryClass; }
+
+void ExpressionNode::annotate(int resultType, Value::MemoryClass memoryClass) {
+  this->resultType = resultType;
+  this->memoryClass = memoryClass;
+}
+
 BooleanValueNode::BooleanValueNode(bool value) : value(value) {}
 
 Node::Type BooleanValueNode::getType() const { return BOOLEAN_VALUE; }
@@ -89,11 +98,14 @@ PrintInstructionNode::PrintInstructionNode(std::unique_ptr<ExpressionNode> expre
 
 Node::Type PrintInstructionNode::getType() const { return PRINT_INSTRUCTION; }
 
-ReadInstructionNode::ReadInstructionNode(std::unique_ptr<ExpressionNode> expression) : expression(
-    std::move(expression)) {}
+ReadInstructionNode::ReadInstructionNode(std::unique_ptr<ExpressionNode> expression,
+                                         std::unique_ptr<ExpressionNode> count)
+    : expression(std::move(expression)), count(std::move(count)) {}
 
 const std::unique_ptr<ExpressionNode>& ReadInstructionNode::getExpression() const { return expression; }
 
+const std::unique_ptr<ExpressionNode>& ReadInstructionNode::getCount() const { return count; }
+
 Node::Type ReadInstructionNode::getType() const { return READ_INSTRUCTION; }
 
 const std::unique_ptr<ExpressionNode>& PrintInstructionNode::getExpression() const { return expression; }
@@ -129,8 +141,9 @@ const std::vector<std::unique_ptr<ExpressionNode>>& ListValueNode::getElements()
   return elements;
 }
 
-ForNode::ForNode(std::string it, std::unique_ptr<ExpressionNode> range, std::unique_ptr<BlockNode> block)
-    : it(std::move(it)), range(std::move(range)), block(std::move(block)) {}
+ForNode::ForNode(std::string it, std::unique_ptr<ExpressionNode> range, std::unique_ptr<BlockNode> block,
+                 bool parallel)
+    : it(std::move(it)), range(std::move(range)), block(std::move(block)), parallel(parallel) {}
 
 Node::Type ForNode::getType() const { return FOR_STATEMENT; }
 
@@ -140,9 +153,12 @@ const std::unique_ptr<ExpressionNode>& ForNode::getRangeExpression() const { ret
 
 const std::unique_ptr<BlockNode>& ForNode::getBlock() const { return block; }
 
+bool ForNode::isParallel() const { return parallel; }
+
 FunctionDefinitionNode::FunctionDefinitionNode(std::string name, std::vector<std::pair<std::string, int>> arguments,
                                                int returnType, std::shared_ptr<BlockNode> block)
-    : name(std::move(name)), arguments(std::move(arguments)), returnType(returnType), block(std::move(block)) {}
+    : name(std::move(name)), arguments(std::move(arguments)), returnType(returnType), block(std::move(block)),
+      bodyPending(false) {}
 
 Node::Type FunctionDefinitionNode::getType() const { return FUNCTION_DEFINITION; }
 
@@ -156,6 +172,20 @@ const std::shared_ptr<BlockNode>& FunctionDefinitionNode::getBlock() const {
   return block;
 }
 
+bool FunctionDefinitionNode::isBodyPending() const { return bodyPending; }
+
+void FunctionDefinitionNode::setBodyPending(bool pending) { bodyPending = pending; }
+
+const std::vector<std::string>& FunctionDefinitionNode::getSideEffects() const { return sideEffects; }
+
+const std::vector<FunctionDefinitionNode*>& FunctionDefinitionNode::getCallees() const { return callees; }
+
+void FunctionDefinitionNode::setEffects(std::vector<std::string> sideEffects,
+                                        std::vector<FunctionDefinitionNode*> callees) {
+  this->sideEffects = std::move(sideEffects);
+  this->callees = std::move(callees);
+}
+
 FunctionCallNode::FunctionCallNode(std::string name, std::vector<std::unique_ptr<ExpressionNode>> arguments)
     : fncName(std::move(name)), arguments(std::move(arguments)) {}
 
@@ -170,3 +200,38 @@ std::string FunctionCallNode::getFunctionName() const {
 const std::vector<std::unique_ptr<ExpressionNode>>& FunctionCallNode::getArguments() const {
   return arguments;
 }
+
+SpawnNode::SpawnNode(std::unique_ptr<FunctionCallNode> call) : call(std::move(call)) {}
+
+Node::Type SpawnNode::getType() const { return SPAWN; }
+
+const std::unique_ptr<FunctionCallNode>& SpawnNode::getCall() const { return call; }
+
+const std::vector<FunctionDefinitionNode*>& SpawnNode::getFunctions() const { return functions; }
+
+void SpawnNode::setFunctions(std::vector<FunctionDefinitionNode*> functions) { this->functions = std::move(functions); }
+
+AwaitNode::AwaitNode(std::unique_ptr<ExpressionNode> task) : task(std::move(task)) {}
+
+Node::Type AwaitNode::getType() const { return AWAIT; }
+
+const std::unique_ptr<ExpressionNode>& AwaitNode::getTask() const { return task; }
+
+ChannelNode::ChannelNode(int channelType, std::unique_ptr<ExpressionNode> capacity)
+    : channelType(channelType), capacity(std::move(capacity)) {}
+
+Node::Type ChannelNode::getType() const { return CHANNEL; }
+
+int ChannelNode::getChannelType() const { return channelType; }
+
+const std::unique_ptr<ExpressionNode>& ChannelNode::getCapacity() const { return capacity; }
+
+ImportNode::ImportNode(std::string path) : path(std::move(path)) {}
+
+Node::Type ImportNode::getType() const { return IMPORT_STATEMENT; }
+
+std::string ImportNode::getPath() const { return path; }
+
+Module* ImportNode::getModule() const { return module.get(); }
+
+void ImportNode::setModule(std::shared_ptr<Module> module) { this->module = std::move(module); }
@@ -1,11 +1,16 @@
 #ifndef PROG_LANG_NODE_H
 #define PROG_LANG_NODE_H
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "types.h"
+#include "value.h"
+
+class FunctionDefinitionNode;
+class Module;
 
 class Node {
  public:
@@ -22,6 +27,9 @@ class Node {
     OBJECT,
     VARIABLE,
     FUNCTION_CALL,
+    SPAWN,
+    AWAIT,
+    CHANNEL,
     UNARY_OPERATOR,
     BINARY_OPERATOR,
     STANDALONE_EXPRESSION,
@@ -30,7 +38,8 @@ class Node {
     READ_INSTRUCTION,
     IF_STATEMENT,
     WHILE_STATEMENT,
-    FOR_STATEMENT
+    FOR_STATEMENT,
+    IMPORT_STATEMENT
   };
 
   virtual ~Node() = default;
@@ -50,6 +59,13 @@ class BlockNode : public Node {
 class ExpressionNode : public Node {
  public:
   Type getType() const override;
+  int getResultType() const;
+  Value::MemoryClass getMemoryClass() const;
+  void annotate(int resultType, Value::MemoryClass memoryClass);
+
+ private:
+  int resultType = TYPE_NONE;
+  Value::MemoryClass memoryClass = Value::RVALUE;
 };
 
 class BooleanValueNode : public ExpressionNode {
@@ -172,6 +188,41 @@ class FunctionCallNode : public ExpressionNode {
   std::vector<std::unique_ptr<ExpressionNode>> arguments;
 };
 
+class SpawnNode : public ExpressionNode {
+ public:
+  explicit SpawnNode(std::unique_ptr<FunctionCallNode> call);
+  Type getType() const override;
+  const std::unique_ptr<FunctionCallNode>& getCall() const;
+  const std::vector<FunctionDefinitionNode*>& getFunctions() const;
+  void setFunctions(std::vector<FunctionDefinitionNode*> functions);
+
+ private:
+  std::unique_ptr<FunctionCallNode> call;
+  std::vector<FunctionDefinitionNode*> functions;
+};
+
+class AwaitNode : public ExpressionNode {
+ public:
+  explicit AwaitNode(std::unique_ptr<ExpressionNode> task);
+  Type getType() const override;
+  const std::unique_ptr<ExpressionNode>& getTask() const;
+
+ private:
+  std::unique_ptr<ExpressionNode> task;
+};
+
+class ChannelNode : public ExpressionNode {
+ public:
+  ChannelNode(int channelType, std::unique_ptr<ExpressionNode> capacity);
+  Type getType() const override;
+  int getChannelType() const;
+  const std::unique_ptr<ExpressionNode>& getCapacity() const;
+
+ private:
+  int channelType;
+  std::unique_ptr<ExpressionNode> capacity;
+};
+
 class StandaloneExpressionNode : public Node {
  public:
   explicit StandaloneExpressionNode(std::unique_ptr<ExpressionNode> expression);
@@ -198,6 +249,16 @@ class VariableDeclarationNode : public Node {
 
 class FunctionDefinitionNode : public Node {
  public:
+  enum SideEffect {
+    ASSIGNS_OUTER,
+    READS_OUTER,
+    PRINTS,
+    READS_INPUT,
+    IMPORTS,
+    MODIFIES_SHARED,
+    SIDE_EFFECT_COUNT
+  };
+
   FunctionDefinitionNode(std::string name, std::vector<std::pair<std::string, int>> arguments, int returnType,
                          std::shared_ptr<BlockNode> block);
   Type getType() const override;
@@ -205,12 +266,20 @@ class FunctionDefinitionNode : public Node {
   const std::vector<std::pair<std::string, int>>& getArguments() const;
   int getReturnType() const;
   const std::shared_ptr<BlockNode>& getBlock() const;
+  bool isBodyPending() const;
+  void setBodyPending(bool pending);
+  const std::vector<std::string>& getSideEffects() const;
+  const std::vector<FunctionDefinitionNode*>& getCallees() const;
+  void setEffects(std::vector<std::string> sideEffects, std::vector<FunctionDefinitionNode*> callees);
 
  private:
   std::string name;
   std::vector<std::pair<std::string, int>> arguments;
   int returnType;
   std::shared_ptr<BlockNode> block;
+  std::atomic<bool> bodyPending;
+  std::vector<std::string> sideEffects;
+  std::vector<FunctionDefinitionNode*> callees;
 };
 
 class ReturnInstructionNode : public Node {
@@ -235,12 +304,15 @@ class PrintInstructionNode : public Node {
 
 class ReadInstructionNode : public Node {
  public:
-  explicit ReadInstructionNode(std::unique_ptr<ExpressionNode> expression);
+  explicit ReadInstructionNode(std::unique_ptr<ExpressionNode> expression,
+                               std::unique_ptr<ExpressionNode> count = nullptr);
   Type getType() const override;
   const std::unique_ptr<ExpressionNode>& getExpression() const;
+  const std::unique_ptr<ExpressionNode>& getCount() const;
 
  private:
   std::unique_ptr<ExpressionNode> expression;
+  std::unique_ptr<ExpressionNode> count;
 };
 
 class IfNode : public Node {
@@ -272,16 +344,32 @@ class WhileNode : public Node {
 
 class ForNode : public Node {
  public:
-  ForNode(std::string it, std::unique_ptr<ExpressionNode> range, std::unique_ptr<BlockNode> block);
+  ForNode(std::string it, std::unique_ptr<ExpressionNode> range, std::unique_ptr<BlockNode> block,
+          bool parallel = false);
   Type getType() const override;
   std::string getIterName() const;
   const std::unique_ptr<ExpressionNode>& getRangeExpression() const;
   const std::unique_ptr<BlockNode>& getBlock() const;
+  bool isParallel() const;
 
  private:
   std::string it;
   std::unique_ptr<ExpressionNode> range;
   std::unique_ptr<BlockNode> block;
+  bool parallel;
+};
+
+class ImportNode : public Node {
+ public:
+  explicit ImportNode(std::string path);
+  Type getType() const override;
+  std::string getPath() const;
+  Module* getModule() const;
+  void setModule(std::shared_ptr<Module> module);
+
+ private:
+  std::string path;
+  std::shared_ptr<Module> module;
 };
 
 #endif //PROG_LANG_NODE_H
@@ -0,0 +1,50 @@
+#include "number_file.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <vector>
+
+#include "mapped_file.h"
+#include "runtime_error.h"
+
+std::shared_ptr<MappedFile> NumberFile::load(const std::string& path) {
+  auto file = std::make_shared<MappedFile>(path);
+  if (file->getSize() % sizeof(double) != 0) {
+    throw RuntimeError("file " + path + " does not hold a whole number of doubles");
+  }
+  return file;
+}
+
+// the data is written next to the target and renamed over it, so arrays still mapped from the old file stay valid
+void NumberFile::save(const std::string& path, const double* data, size_t size) {
+  std::vector<char> name(path.begin(), path.end());
+  const char suffix[] = ".XXXXXX";
+  name.insert(name.end(), suffix, suffix + sizeof(suffix));
+  int fd = mkstemp(name.data());
+  if (fd < 0) {
+    throw RuntimeError("can not write file " + path);
+  }
+  auto bytes = reinterpret_cast<const char*>(data);
+  size_t remaining = size * sizeof(double);
+  bool failed = fchmod(fd, 0644) < 0;
+  while (!failed && remaining > 0) {
+    ssize_t count = write(fd, bytes, remaining);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    failed = count < 0;
+    if (!failed) {
+      bytes += count;
+      remaining -= count;
+    }
+  }
+  failed = close(fd) < 0 || failed;
+  if (failed || std::rename(name.data(), path.c_str()) < 0) {
+    unlink(name.data());
+    throw RuntimeError("can not write file " + path);
+  }
+}
@@ -0,0 +1,16 @@
+#ifndef PROG_LANG_NUMBER_FILE_H
+#define PROG_LANG_NUMBER_FILE_H
+
+#include <memory>
+#include <string>
+
+class MappedFile;
+
+// Files of raw little-endian doubles, the binary format of loadNumbers and saveNumbers
+class NumberFile {
+ public:
+  static std::shared_ptr<MappedFile> load(const std::string& path);
+  static void save(const std::string& path, const double* data, size_t size);
+};
+
+#endif //PROG_LANG_NUMBER_FILE_H
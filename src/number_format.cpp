@@ -0,0 +1,50 @@
+#include "number_format.h"
+
+#include <charconv>
+#include <cmath>
+
+#include "runtime_error.h"
+
+namespace {
+// integers below this bound are exact in a double, so they print without an exponent
+constexpr double EXACT_INTEGER_LIMIT = 9007199254740992.0;
+
+bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+}
+
+char* NumberFormat::format(char* first, double value) {
+  char* last = first + MAX_LENGTH;
+  if (std::fabs(value) < EXACT_INTEGER_LIMIT && value == std::trunc(value)) {
+    return std::to_chars(first, last, value, std::chars_format::fixed).ptr;
+  }
+  return std::to_chars(first, last, value).ptr;
+}
+
+std::string NumberFormat::toString(double value) {
+  char buffer[MAX_LENGTH];
+  return std::string(buffer, format(buffer, value));
+}
+
+bool NumberFormat::parse(const char* first, const char* last, double& value) {
+  if (first != last && *first == '+' && last - first > 1 && first[1] != '-') {
+    ++first;
+  }
+  auto result = std::from_chars(first, last, value);
+  return result.ec == std::errc() && result.ptr == last;
+}
+
+double NumberFormat::parse(const std::string& text) {
+  const char* first = text.data();
+  const char* last = first + text.size();
+  while (first != last && isSpace(*first)) {
+    ++first;
+  }
+  while (last != first && isSpace(last[-1])) {
+    --last;
+  }
+  double value;
+  if (!parse(first, last, value)) {
+    throw RuntimeError("can not convert \"" + text + "\" to number");
+  }
+  return value;
+}
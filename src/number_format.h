@@ -0,0 +1,19 @@
+#ifndef PROG_LANG_NUMBER_FORMAT_H
+#define PROG_LANG_NUMBER_FORMAT_H
+
+#include <cstddef>
+#include <string>
+
+// Locale independent conversions between numbers and text; formatting prints the shortest string that parses back
+// to the same double
+class NumberFormat {
+ public:
+  static constexpr size_t MAX_LENGTH = 32;
+
+  static char* format(char* first, double value);
+  static std::string toString(double value);
+  static bool parse(const char* first, const char* last, double& value);
+  static double parse(const std::string& text);
+};
+
+#endif //PROG_LANG_NUMBER_FORMAT_H
@@ -0,0 +1,181 @@
+#include "numeric_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PROG_LANG_X86
+#endif
+
+namespace {
+double sumScalar(const double* data, size_t size) {
+  double total = 0;
+  for (size_t i = 0; i < size; ++i) {
+    total += data[i];
+  }
+  return total;
+}
+
+// a NaN anywhere makes min and max NaN, as it does sum, on every code path
+double minScalar(const double* data, size_t size) {
+  double best = data[0];
+  for (size_t i = 0; i < size; ++i) {
+    if (std::isnan(data[i])) {
+      return data[i];
+    }
+    best = data[i] < best ? data[i] : best;
+  }
+  return best;
+}
+
+double maxScalar(const double* data, size_t size) {
+  double best = data[0];
+  for (size_t i = 0; i < size; ++i) {
+    if (std::isnan(data[i])) {
+      return data[i];
+    }
+    best = data[i] > best ? data[i] : best;
+  }
+  return best;
+}
+
+double dotScalar(const double* lhs, const double* rhs, size_t size) {
+  double total = 0;
+  for (size_t i = 0; i < size; ++i) {
+    total += lhs[i] * rhs[i];
+  }
+  return total;
+}
+
+#ifdef PROG_LANG_X86
+__attribute__((target("avx2"))) double horizontalSum(__m256d v) {
+  __m128d low = _mm256_castpd256_pd128(v);
+  __m128d high = _mm256_extractf128_pd(v, 1);
+  low = _mm_add_pd(low, high);
+  return _mm_cvtsd_f64(_mm_add_sd(low, _mm_unpackhi_pd(low, low)));
+}
+
+__attribute__((target("avx2"))) double sumAvx2(const double* data, size_t size) {
+  __m256d first = _mm256_setzero_pd();
+  __m256d second = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    first = _mm256_add_pd(first, _mm256_loadu_pd(data + i));
+    second = _mm256_add_pd(second, _mm256_loadu_pd(data + i + 4));
+  }
+  double total = horizontalSum(_mm256_add_pd(first, second));
+  return total + sumScalar(data + i, size - i);
+}
+
+__attribute__((target("avx2"))) double minAvx2(const double* data, size_t size) {
+  if (size < 4) {
+    return minScalar(data, size);
+  }
+  __m256d best = _mm256_loadu_pd(data);
+  // min_pd drops a NaN in its first operand, so NaNs are tracked separately
+  __m256d unordered = _mm256_cmp_pd(best, best, _CMP_UNORD_Q);
+  size_t i = 4;
+  for (; i + 4 <= size; i += 4) {
+    __m256d values = _mm256_loadu_pd(data + i);
+    unordered = _mm256_or_pd(unordered, _mm256_cmp_pd(values, values, _CMP_UNORD_Q));
+    best = _mm256_min_pd(best, values);
+  }
+  if (_mm256_movemask_pd(unordered) != 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes, best);
+  double result = minScalar(lanes, 4);
+  if (i == size) {
+    return result;
+  }
+  double rest = minScalar(data + i, size - i);
+  return std::isnan(rest) ? rest : std::min(result, rest);
+}
+
+__attribute__((target("avx2"))) double maxAvx2(const double* data, size_t size) {
+  if (size < 4) {
+    return maxScalar(data, size);
+  }
+  __m256d best = _mm256_loadu_pd(data);
+  // max_pd drops a NaN in its first operand, so NaNs are tracked separately
+  __m256d unordered = _mm256_cmp_pd(best, best, _CMP_UNORD_Q);
+  size_t i = 4;
+  for (; i + 4 <= size; i += 4) {
+    __m256d values = _mm256_loadu_pd(data + i);
+    unordered = _mm256_or_pd(unordered, _mm256_cmp_pd(values, values, _CMP_UNORD_Q));
+    best = _mm256_max_pd(best, values);
+  }
+  if (_mm256_movemask_pd(unordered) != 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  double lanes[4];
+  _mm256_storeu_pd(lanes, best);
+  double result = maxScalar(lanes, 4);
+  if (i == size) {
+    return result;
+  }
+  double rest = maxScalar(data + i, size - i);
+  return std::isnan(rest) ? rest : std::max(result, rest);
+}
+
+__attribute__((target("avx2"))) double dotAvx2(const double* lhs, const double* rhs, size_t size) {
+  __m256d first = _mm256_setzero_pd();
+  __m256d second = _mm256_setzero_pd();
+  size_t i = 0;
+  for (; i + 8 <= size; i += 8) {
+    first = _mm256_add_pd(first, _mm256_mul_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+    second = _mm256_add_pd(second, _mm256_mul_pd(_mm256_loadu_pd(lhs + i + 4), _mm256_loadu_pd(rhs + i + 4)));
+  }
+  double total = horizontalSum(_mm256_add_pd(first, second));
+  return total + dotScalar(lhs + i, rhs + i, size - i);
+}
+#endif
+}
+
+double NumericKernels::sum(const double* data, size_t size) {
+#ifdef PROG_LANG_X86
+  if (hasAvx2()) {
+    return sumAvx2(data, size);
+  }
+#endif
+  return sumScalar(data, size);
+}
+
+double NumericKernels::min(const double* data, size_t size) {
+#ifdef PROG_LANG_X86
+  if (hasAvx2()) {
+    return minAvx2(data, size);
+  }
+#endif
+  return minScalar(data, size);
+}
+
+double NumericKernels::max(const double* data, size_t size) {
+#ifdef PROG_LANG_X86
+  if (hasAvx2()) {
+    return maxAvx2(data, size);
+  }
+#endif
+  return maxScalar(data, size);
+}
+
+double NumericKernels::dot(const double* lhs, const double* rhs, size_t size) {
+#ifdef PROG_LANG_X86
+  if (hasAvx2()) {
+    return dotAvx2(lhs, rhs, size);
+  }
+#endif
+  return dotScalar(lhs, rhs, size);
+}
+
+bool NumericKernels::hasAvx2() {
+#ifdef PROG_LANG_X86
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,18 @@
+#ifndef PROG_LANG_NUMERIC_KERNELS_H
+#define PROG_LANG_NUMERIC_KERNELS_H
+
+#include <cstddef>
+
+// Reductions over contiguous doubles; AVX2 versions are picked at runtime when the CPU supports them
+class NumericKernels {
+ public:
+  static double sum(const double* data, size_t size);
+  static double min(const double* data, size_t size);
+  static double max(const double* data, size_t size);
+  static double dot(const double* lhs, const double* rhs, size_t size);
+
+ private:
+  static bool hasAvx2();
+};
+
+#endif //PROG_LANG_NUMERIC_KERNELS_H
@@ -1,14 +1,13 @@
 #include "operator.h"
 
-#include <memory>
+#include <algorithm>
 
 namespace {
 typedef std::map<std::string, OperatorTokenType> Map;
-std::unique_ptr<Map> operatorTokenMapping;
 }
 
-void initializeOperatorTokenMapping() {
-  Map mp{
+const Map& operatorTokenMap() {
+  static const Map mp{
       {".", OP_DOT},
       {",", OP_COMMA},
       {"+", OP_PLUS},
@@ -41,9 +40,16 @@ void initializeOperatorTokenMapping() {
       {">=", OP_IS_GREATER_EQUAL},
       {"!=", OP_IS_DIFFERENT},
   };
-  operatorTokenMapping = std::make_unique<Map>(std::move(mp));
+  return mp;
 }
 
-const Map& operatorTokenMap() {
-  return *operatorTokenMapping;
+std::size_t maxOperatorLength() {
+  static const std::size_t length = [] {
+    std::size_t ans = 0;
+    for (const auto& it : operatorTokenMap()) {
+      ans = std::max(ans, it.first.size());
+    }
+    return ans;
+  }();
+  return length;
 }
@@ -35,10 +35,11 @@ enum OperatorTokenType {
   OP_IS_GREATER_THAN,
   OP_IS_LESS_EQUAL,
   OP_IS_GREATER_EQUAL,
-  OP_IS_DIFFERENT
+  OP_IS_DIFFERENT,
+  OP_COUNT
 };
 
-void initializeOperatorTokenMapping();
 const std::map<std::string, OperatorTokenType>& operatorTokenMap();
+std::size_t maxOperatorLength();
 
 #endif //PROG_LANG_OPERATOR_H
@@ -0,0 +1,71 @@
+#include "output_buffer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+
+OutputBuffer::OutputBuffer(int fd, size_t size, bool lineBuffered)
+    : fd(fd), buffer(std::max<size_t>(size, 1)), lineBuffered(lineBuffered) {
+  setp(buffer.data(), buffer.data() + buffer.size());
+}
+
+OutputBuffer::~OutputBuffer() { flushBuffer(); }
+
+OutputBuffer::int_type OutputBuffer::overflow(int_type ch) {
+  if (!flushBuffer()) {
+    return traits_type::eof();
+  }
+  if (traits_type::eq_int_type(ch, traits_type::eof())) {
+    return traits_type::not_eof(ch);
+  }
+  *pptr() = traits_type::to_char_type(ch);
+  pbump(1);
+  if (lineBuffered && traits_type::to_char_type(ch) == '\n' && !flushBuffer()) {
+    return traits_type::eof();
+  }
+  return ch;
+}
+
+std::streamsize OutputBuffer::xsputn(const char* data, std::streamsize count) {
+  auto size = static_cast<size_t>(count);
+  if (size > static_cast<size_t>(epptr() - pptr())) {
+    if (!flushBuffer()) {
+      return 0;
+    }
+    // larger than the whole buffer: copying it first would only add a second pass
+    if (size >= buffer.size()) {
+      return writeAll(data, size) ? count : 0;
+    }
+  }
+  std::memcpy(pptr(), data, size);
+  pbump(static_cast<int>(size));
+  if (lineBuffered && std::memchr(data, '\n', size) != nullptr && !flushBuffer()) {
+    return 0;
+  }
+  return count;
+}
+
+int OutputBuffer::sync() { return flushBuffer() ? 0 : -1; }
+
+bool OutputBuffer::writeAll(const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= written;
+  }
+  return true;
+}
+
+bool OutputBuffer::flushBuffer() {
+  bool written = writeAll(pbase(), pptr() - pbase());
+  setp(buffer.data(), buffer.data() + buffer.size());
+  return written;
+}
@@ -0,0 +1,30 @@
+#ifndef PROG_LANG_OUTPUT_BUFFER_H
+#define PROG_LANG_OUTPUT_BUFFER_H
+
+#include <streambuf>
+#include <vector>
+
+// Stream buffer writing straight to a file descriptor. It is flushed when full, on explicit flushes and, when line
+// buffered, after every newline
+class OutputBuffer : public std::streambuf {
+ public:
+  OutputBuffer(int fd, size_t size, bool lineBuffered);
+  OutputBuffer(const OutputBuffer&) = delete;
+  OutputBuffer& operator=(const OutputBuffer&) = delete;
+  ~OutputBuffer() override;
+
+ protected:
+  int_type overflow(int_type ch) override;
+  std::streamsize xsputn(const char* data, std::streamsize count) override;
+  int sync() override;
+
+ private:
+  bool writeAll(const char* data, size_t size);
+  bool flushBuffer();
+
+  int fd;
+  std::vector<char> buffer;
+  bool lineBuffered;
+};
+
+#endif //PROG_LANG_OUTPUT_BUFFER_H
@@ -46,6 +46,10 @@ Parser::Type Parser::getInstructionType(const TokenList& tokenList) {
         return PRINT_STATEMENT;
       case KEYWORD_READ:
         return READ_STATEMENT;
+      case KEYWORD_IMPORT:
+        return IMPORT_STATEMENT;
+      case KEYWORD_PARALLEL:
+        return PARALLEL_FOR;
       default:
         return EXPRESSION;
     }
@@ -65,7 +69,8 @@ std::unique_ptr<BlockNode> Parser::parseBlock(TokenIter& iter) {
     std::unique_ptr<BlockNode> block1;
     std::unique_ptr<BlockNode> block2;
     auto it = currentInstruction.cbegin();
-    switch (getInstructionType(currentInstruction)) {
+    auto instructionType = getInstructionType(currentInstruction);
+    switch (instructionType) {
       case EXPRESSION:
         node = parseExpression(it);
         if ((*it)->getType() != Token::LINE_FEED) {
@@ -96,6 +101,9 @@ std::unique_ptr<BlockNode> Parser::parseBlock(TokenIter& iter) {
       case READ_STATEMENT:
         node = parseReadStatement(currentInstruction);
         break;
+      case IMPORT_STATEMENT:
+        node = parseImportStatement(currentInstruction);
+        break;
       case IF:
         condition = parseCondition(currentInstruction);
         if ((*iter)->getType() != Token::INDENT ||
@@ -129,18 +137,27 @@ std::unique_ptr<BlockNode> Parser::parseBlock(TokenIter& iter) {
         block1 = parseBlock(iter);
         node = std::make_unique<WhileNode>(std::move(condition), std::move(block1));
         break;
-      case FOR: {
-        if (currentInstruction[2]->getType() != Token::IDENTIFIER) {
-          throw SyntaxError(currentInstruction[2]->getLocation(), "expected identifier");
+      case FOR:
+      case PARALLEL_FOR: {
+        size_t first = 2;
+        if (instructionType == PARALLEL_FOR) {
+          if (currentInstruction[2]->getType() != Token::KEYWORD
+              || std::dynamic_pointer_cast<KeywordToken>(currentInstruction[2])->getKeyword() != KEYWORD_FOR) {
+            throw SyntaxError(currentInstruction[2]->getLocation(), "expected for");
+          }
+          first = 3;
+        }
+        if (currentInstruction[first]->getType() != Token::IDENTIFIER) {
+          throw SyntaxError(currentInstruction[first]->getLocation(), "expected identifier");
         }
-        if (currentInstruction[3]->getType() != Token::OPERATOR
-            || std::dynamic_pointer_cast<OperatorToken>(currentInstruction[3])->getOperator() != OP_COLON) {
-          throw SyntaxError(currentInstruction[3]->getLocation(), "expected colon");
+        if (currentInstruction[first + 1]->getType() != Token::OPERATOR
+            || std::dynamic_pointer_cast<OperatorToken>(currentInstruction[first + 1])->getOperator() != OP_COLON) {
+          throw SyntaxError(currentInstruction[first + 1]->getLocation(), "expected colon");
         }
-        if (currentInstruction[4]->getType() == Token::LINE_FEED) {
-          throw SyntaxError(currentInstruction[4]->getLocation(), "expected expression");
+        if (currentInstruction[first + 2]->getType() == Token::LINE_FEED) {
+          throw SyntaxError(currentInstruction[first + 2]->getLocation(), "expected expression");
         }
-        auto i = currentInstruction.cbegin() + 4;
+        auto i = currentInstruction.cbegin() + first + 2;
         auto loop = ExpressionParser::parse(i);
         if ((*iter)->getType() != Token::INDENT ||
             std::dynamic_pointer_cast<IndentToken>(*iter)->getSize() <= baseIndent) {
@@ -148,9 +165,10 @@ std::unique_ptr<BlockNode> Parser::parseBlock(TokenIter& iter) {
         }
         block1 = parseBlock(iter);
         node = std::make_unique<ForNode>(
-            std::dynamic_pointer_cast<IdentifierToken>(currentInstruction[2])->getName(),
+            std::dynamic_pointer_cast<IdentifierToken>(currentInstruction[first])->getName(),
             std::move(loop),
-            std::move(block1)
+            std::move(block1),
+            instructionType == PARALLEL_FOR
         );
         break;
       }
@@ -193,11 +211,38 @@ int Parser::parseType(TokenIter& iter) {
     case KEYWORD_STRING:
       type = TYPE_STRING;
       break;
+    case KEYWORD_TASK:
+      ++iter;
+      if ((*iter)->getType() != Token::OPERATOR
+          || std::dynamic_pointer_cast<OperatorToken>(*iter)->getOperator() != OP_IS_LESS_THAN) {
+        throw SyntaxError((*iter)->getLocation(), "expected task type specifier");
+      }
+      type = TYPE_TASK(parseType(++iter));
+      if ((*iter)->getType() != Token::OPERATOR
+          || std::dynamic_pointer_cast<OperatorToken>(*iter)->getOperator() != OP_IS_GREATER_THAN) {
+        throw SyntaxError((*iter)->getLocation(), "expected closing angular bracket");
+      }
+      break;
+    case KEYWORD_CHANNEL:
+      ++iter;
+      if ((*iter)->getType() != Token::OPERATOR
+          || std::dynamic_pointer_cast<OperatorToken>(*iter)->getOperator() != OP_IS_LESS_THAN) {
+        throw SyntaxError((*iter)->getLocation(), "expected channel type specifier");
+      }
+      type = TYPE_CHANNEL(parseType(++iter));
+      if ((*iter)->getType() != Token::OPERATOR
+          || std::dynamic_pointer_cast<OperatorToken>(*iter)->getOperator() != OP_IS_GREATER_THAN) {
+        throw SyntaxError((*iter)->getLocation(), "expected closing angular bracket");
+      }
+      break;
     default:
       throw SyntaxError((*iter)->getLocation(), "expected type specifier");
   }
   ++iter;
   while (nestedArrays--) {
+    if (!isTypeNestable(type)) {
+      throw SyntaxError((*iter)->getLocation(), "arrays nested too deeply");
+    }
     type = TYPE_ARRAY(type);
     if ((*iter)->getType() != Token::OPERATOR
         || std::dynamic_pointer_cast<OperatorToken>(*iter)->getOperator() != OP_IS_GREATER_THAN) {
@@ -300,7 +345,25 @@ std::unique_ptr<ReadInstructionNode> Parser::parseReadStatement(const TokenList&
   if ((*iter)->getType() == Token::LINE_FEED) {
     throw SyntaxError((*iter)->getLocation(), "expected expression");
   }
-  return std::make_unique<ReadInstructionNode>(ExpressionParser::parse(iter));
+  auto expression = ExpressionParser::parse(iter);
+  if ((*iter)->getType() != Token::OPERATOR
+      || std::dynamic_pointer_cast<OperatorToken>(*iter)->getOperator() != OP_COMMA) {
+    return std::make_unique<ReadInstructionNode>(std::move(expression));
+  }
+  return std::make_unique<ReadInstructionNode>(std::move(expression), ExpressionParser::parse(++iter));
+}
+
+std::unique_ptr<ImportNode> Parser::parseImportStatement(const TokenList& tokenList) {
+  auto iter = tokenList.begin() + 2;
+  if ((*iter)->getType() != Token::STRING) {
+    throw SyntaxError((*iter)->getLocation(), "expected module path");
+  }
+  auto path = std::dynamic_pointer_cast<StringToken>(*iter)->getValue();
+  ++iter;
+  if ((*iter)->getType() != Token::LINE_FEED) {
+    throw SyntaxError((*iter)->getLocation(), "expected end of line");
+  }
+  return std::make_unique<ImportNode>(path);
 }
 
 std::unique_ptr<ExpressionNode> Parser::parseCondition(const TokenList& tokenList) {
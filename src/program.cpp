@@ -0,0 +1,112 @@
+#include "program.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "context.h"
+#include "lexer.h"
+#include "parser.h"
+#include "semantic_analyzer.h"
+#include "semantic_error.h"
+#include "vm.h"
+
+std::unique_ptr<Program> Program::compileFile(const std::string& fileName, bool lazyFunctionAnalysis) {
+  std::ifstream input(fileName);
+  if (!input) {
+    throw SemanticError("can not open source file " + fileName);
+  }
+  std::unique_ptr<Program> program(new Program(fileName, lazyFunctionAnalysis));
+  program->compile(Lexer::readSourceLines(input));
+  return program;
+}
+
+std::unique_ptr<Program> Program::compileSource(const std::string& source, const std::string& fileName,
+                                                bool lazyFunctionAnalysis) {
+  std::istringstream input(source);
+  std::unique_ptr<Program> program(new Program(fileName, lazyFunctionAnalysis));
+  program->compile(Lexer::readSourceLines(input));
+  return program;
+}
+
+void Program::run(std::istream& input, std::ostream& output, const std::vector<std::string>& arguments) const {
+  Context context(input, output);
+  context.setLazyFunctionAnalysis(lazyFunctionAnalysis);
+  context.getModuleLoader().setMainFile(fileName);
+  declareArguments(context, arguments);
+  VirtualMachine(context).run(tree.get());
+  context.joinTasks();
+}
+
+void Program::runEachLine(std::istream& input, std::ostream& output, const std::vector<std::string>& arguments) const {
+  Context context(input, output);
+  context.setLazyFunctionAnalysis(lazyFunctionAnalysis);
+  context.getModuleLoader().setMainFile(fileName);
+  declareArguments(context, arguments);
+  VirtualMachine vm(context);
+  // the top level runs without a block of its own, so that its globals and functions outlive it
+  context.getStore().newLevel();
+  for (const auto& node : tree->getContent()) {
+    vm.run(node.get());
+  }
+  auto begin = findHandler(context, "begin", {}, false);
+  auto handle = findHandler(context, "handle", {TYPE_STRING}, true);
+  auto end = findHandler(context, "end", {}, false);
+  if (begin != nullptr) {
+    vm.call(begin, {});
+  }
+  std::string line;
+  auto& scanner = context.getScanner();
+  while (scanner.nextLine(line)) {
+    std::vector<std::unique_ptr<Value>> lineArgument;
+    lineArgument.push_back(std::make_unique<StringRvalue>(line));
+    vm.call(handle, std::move(lineArgument));
+  }
+  if (end != nullptr) {
+    vm.call(end, {});
+  }
+  context.joinTasks();
+}
+
+FunctionData* Program::findHandler(Context& context, const std::string& name, const std::vector<int>& argumentTypes,
+                                   bool required) {
+  auto& store = context.getStore();
+  if (store.getLevelOf(name) == -1) {
+    if (required) {
+      throw SemanticError("each-line mode requires a " + name + " function");
+    }
+    return nullptr;
+  }
+  auto function = store.getFunctionData(name);
+  std::vector<int> types;
+  for (const auto& argument : function->getArguments()) {
+    types.push_back(argument.second);
+  }
+  if (types != argumentTypes) {
+    throw SemanticError(name + " function should accept " +
+                        (argumentTypes.empty() ? std::string("no arguments") : std::string("one string argument")));
+  }
+  return function;
+}
+
+Program::Program(std::string fileName, bool lazyFunctionAnalysis)
+    : fileName(std::move(fileName)), lazyFunctionAnalysis(lazyFunctionAnalysis) {}
+
+void Program::compile(const std::vector<std::string>& lines) {
+  tree = Parser::parseFile(Lexer::readLines(lines));
+  Context context;
+  context.setLazyFunctionAnalysis(lazyFunctionAnalysis);
+  context.getModuleLoader().setMainFile(fileName);
+  declareArguments(context, {});
+  SemanticAnalyzer(context).analyze(tree.get());
+}
+
+void Program::declareArguments(Context& context, const std::vector<std::string>& arguments) const {
+  std::vector<std::shared_ptr<Rvalue>> values;
+  for (const auto& argument : arguments) {
+    values.push_back(std::make_shared<StringRvalue>(argument));
+  }
+  int type = TYPE_ARRAY(TYPE_STRING);
+  context.getStore().newLevel();
+  context.getStore().registerName("args",
+      std::make_unique<VariableData>(type, std::make_unique<ArrayRvalue>(type, std::move(values))));
+}
@@ -0,0 +1,35 @@
+#ifndef PROG_LANG_PROGRAM_H
+#define PROG_LANG_PROGRAM_H
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "node.h"
+
+class Context;
+class FunctionData;
+
+class Program {
+ public:
+  static std::unique_ptr<Program> compileFile(const std::string& fileName, bool lazyFunctionAnalysis = false);
+  static std::unique_ptr<Program> compileSource(const std::string& source, const std::string& fileName = "<source>",
+                                                bool lazyFunctionAnalysis = false);
+  void run(std::istream& input, std::ostream& output, const std::vector<std::string>& arguments = {}) const;
+  // runs the top level once, then begin(), handle(line) for every input line and end(); begin and end are optional
+  void runEachLine(std::istream& input, std::ostream& output, const std::vector<std::string>& arguments = {}) const;
+
+ private:
+  Program(std::string fileName, bool lazyFunctionAnalysis);
+  void compile(const std::vector<std::string>& lines);
+  void declareArguments(Context& context, const std::vector<std::string>& arguments) const;
+  static FunctionData* findHandler(Context& context, const std::string& name, const std::vector<int>& argumentTypes,
+                                   bool required);
+
+  std::string fileName;
+  bool lazyFunctionAnalysis;
+  std::unique_ptr<BlockNode> tree;
+};
+
+#endif //PROG_LANG_PROGRAM_H
@@ -0,0 +1,31 @@
+#include "program_cache.h"
+
+ProgramCache::ProgramCache(size_t capacity, bool lazyFunctionAnalysis)
+    : capacity(capacity), lazyFunctionAnalysis(lazyFunctionAnalysis) {}
+
+std::shared_ptr<const Program> ProgramCache::get(const std::string& fileName, const std::string& source) {
+  std::size_t hash = std::hash<std::string>()(fileName + '\0' + source);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(hash);
+    if (it != index.end() && it->second->fileName == fileName && it->second->source == source) {
+      entries.splice(entries.begin(), entries, it->second);
+      return it->second->program;
+    }
+  }
+  // compiled without the lock; concurrent misses for the same script just compile it twice
+  std::shared_ptr<const Program> program = Program::compileSource(source, fileName, lazyFunctionAnalysis);
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = index.find(hash);
+  if (it != index.end()) {
+    entries.erase(it->second);
+    index.erase(it);
+  }
+  entries.push_front({hash, fileName, source, program});
+  index[hash] = entries.begin();
+  while (entries.size() > capacity) {
+    index.erase(entries.back().hash);
+    entries.pop_back();
+  }
+  return program;
+}
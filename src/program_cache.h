@@ -0,0 +1,33 @@
+#ifndef PROG_LANG_PROGRAM_CACHE_H
+#define PROG_LANG_PROGRAM_CACHE_H
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "program.h"
+
+// Least recently used compiled programs, keyed by the hash of their file name and source
+class ProgramCache {
+ public:
+  ProgramCache(size_t capacity, bool lazyFunctionAnalysis);
+  std::shared_ptr<const Program> get(const std::string& fileName, const std::string& source);
+
+ private:
+  struct Entry {
+    std::size_t hash;
+    std::string fileName;
+    std::string source;
+    std::shared_ptr<const Program> program;
+  };
+
+  size_t capacity;
+  bool lazyFunctionAnalysis;
+  std::mutex mutex;
+  std::list<Entry> entries;
+  std::unordered_map<std::size_t, std::list<Entry>::iterator> index;
+};
+
+#endif //PROG_LANG_PROGRAM_CACHE_H
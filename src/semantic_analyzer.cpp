@@ -1,7 +1,11 @@
 #include "semantic_analyzer.h"
 
+#include <algorithm>
+
+#include "context.h"
 #include "semantic_error.h"
-#include "store.h"
+
+SemanticAnalyzer::SemanticAnalyzer(Context& context) : context(context), store(context.getStore()) {}
 
 void SemanticAnalyzer::analyze(Node* node, bool allowReturn, int retType) {
   if (node->getType() == Node::BLOCK) {
@@ -14,6 +18,9 @@ void SemanticAnalyzer::analyze(Node* node, bool allowReturn, int retType) {
   } else if (node->getType() == Node::STANDALONE_EXPRESSION) {
     analyzeExpr(dynamic_cast<StandaloneExpressionNode*>(node)->getExpression().get());
   } else if (node->getType() == Node::RETURN_INSTRUCTION) {
+    if (!effectScopes.empty() && effectScopes.back().function == nullptr) {
+      throw SemanticError("return is not available inside parallel for");
+    }
     if (!allowReturn) {
       throw SemanticError("return is not available outside of a function");
     }
@@ -39,16 +46,27 @@ void SemanticAnalyzer::analyze(Node* node, bool allowReturn, int retType) {
     if (eType != TYPE_BOOLEAN && eType != TYPE_NUMBER && eType != TYPE_STRING) {
       throw SemanticError("print statement only accepts primitive types");
     }
+    recordSideEffect(FunctionDefinitionNode::PRINTS, "prints output");
   } else if (node->getType() == Node::READ_INSTRUCTION) {
-    auto exprToRead = dynamic_cast<ReadInstructionNode*>(node)->getExpression().get();
+    auto readNode = dynamic_cast<ReadInstructionNode*>(node);
+    auto exprToRead = readNode->getExpression().get();
     analyzeExpr(exprToRead);
     int eType = getExpressionType(exprToRead);
-    if (eType != TYPE_BOOLEAN && eType != TYPE_NUMBER && eType != TYPE_STRING) {
+    if (readNode->getCount()) {
+      analyzeExpr(readNode->getCount().get());
+      if (getExpressionType(readNode->getCount().get()) != TYPE_NUMBER) {
+        throw SemanticError("read count should be a number");
+      }
+      if (eType != TYPE_ARRAY(TYPE_NUMBER) && eType != TYPE_ARRAY(TYPE_STRING)) {
+        throw SemanticError("read with a count only accepts arrays of numbers or strings");
+      }
+    } else if (eType != TYPE_BOOLEAN && eType != TYPE_NUMBER && eType != TYPE_STRING) {
       throw SemanticError("read statement only accepts primitive types");
     }
     if (getExpressionMemoryClass(exprToRead) == Value::RVALUE) {
       throw SemanticError("rvalue as argument for read statement");
     }
+    recordSideEffect(FunctionDefinitionNode::READS_INPUT, "reads input");
   } else if (node->getType() == Node::VARIABLE_DECLARATION) {
     auto varDecNode = dynamic_cast<VariableDeclarationNode*>(node);
     int type = varDecNode->getVariableType();
@@ -85,25 +103,17 @@ void SemanticAnalyzer::analyze(Node* node, bool allowReturn, int retType) {
     } else if (type == TYPE_NONE) {
       throw SemanticError("variable without type requires initializer");
     }
-    store.registerName(varDecNode->getVariableName(), std::make_unique<VariableData>(type, nullptr));
+    registerVariable(varDecNode->getVariableName(), type,
+                     varDecNode->getInitializer() && !isFreshArray(varDecNode->getInitializer().get()));
   } else if (node->getType() == Node::FUNCTION_DEFINITION) {
     auto fncDefNode = dynamic_cast<FunctionDefinitionNode*>(node);
-    std::string fncName = fncDefNode->getFunctionName();
-    const auto& arguments = fncDefNode->getArguments();
-    int rt = fncDefNode->getReturnType();
-    for (size_t i = 0; i < arguments.size(); ++i)
-      for (size_t j = i + 1; j < arguments.size(); ++j) {
-        if (arguments[i].first == arguments[j].first) {
-          throw SemanticError("cannot have multiple arguments with the same name");
-        }
-      }
-    store.registerName(fncName, std::make_unique<FunctionData>(arguments, rt, fncDefNode->getBlock()));
-    store.newLevel();
-    for (const auto& arg : arguments) {
-      store.registerName(arg.first, std::make_unique<VariableData>(arg.second, nullptr));
+    registerFunction(fncDefNode);
+    if (context.isLazyFunctionAnalysis()) {
+      fncDefNode->setBodyPending(true);
+    } else {
+      analyzeFunctionBody(fncDefNode);
+      runDeferredChecks(fncDefNode);
     }
-    analyze(fncDefNode->getBlock().get(), true, rt);
-    store.deleteLevel();
   } else if (node->getType() == Node::IF_STATEMENT) {
     auto ifNode = dynamic_cast<IfNode*>(node);
     analyzeExpr(ifNode->getCondition().get());
@@ -126,28 +136,299 @@ void SemanticAnalyzer::analyze(Node* node, bool allowReturn, int retType) {
     auto range = forNode->getRangeExpression().get();
     analyzeExpr(range);
     int eType = getExpressionType(range);
-    if (eType != TYPE_STRING && !isTypeArray(eType) && !isTypeList(eType)) {
-      throw SemanticError("iteration can only be performed on strings and arrays");
+    if ((isTypeChannel(eType) || eType == TYPE_LINES) && forNode->isParallel()) {
+      throw SemanticError("parallel iteration can not be performed on channels and file lines");
+    }
+    if (eType != TYPE_STRING && !isTypeArray(eType) && !isTypeList(eType) && !isTypeChannel(eType) &&
+        eType != TYPE_LINES) {
+      throw SemanticError("iteration can only be performed on strings, arrays, channels and file lines");
     }
     if (isTypeList(eType) && getListElementType(eType) == TYPE_MIXED) {
       throw SemanticError("iteration can not be performed on mixed type lists");
     }
     store.newLevel();
     int elemType =
-        eType == TYPE_STRING ? TYPE_STRING : isTypeArray(eType) ? getArrayElementType(eType) : getListElementType(
-            eType);
-    store.registerName(forNode->getIterName(), std::make_unique<VariableData>(elemType, nullptr));
-    analyze(forNode->getBlock().get(), allowReturn, retType);
+        eType == TYPE_STRING || eType == TYPE_LINES ? TYPE_STRING : isTypeArray(eType) ? getArrayElementType(eType) :
+        isTypeChannel(eType) ? getChannelElementType(eType) : getListElementType(eType);
+    registerVariable(forNode->getIterName(), elemType, true);
+    if (forNode->isParallel()) {
+      analyzeParallelBody(forNode);
+    } else {
+      analyze(forNode->getBlock().get(), allowReturn, retType);
+    }
     store.deleteLevel();
+  } else if (node->getType() == Node::IMPORT_STATEMENT) {
+    auto importNode = dynamic_cast<ImportNode*>(node);
+    recordSideEffect(FunctionDefinitionNode::IMPORTS, "imports a module");
+    auto module = context.getModuleLoader().load(importNode->getPath());
+    importNode->setModule(module);
+    store.importLevel(context.getModuleLoader().getDeclarations(module.get()));
+  }
+}
+
+void SemanticAnalyzer::registerFunction(FunctionDefinitionNode* node) {
+  const auto& arguments = node->getArguments();
+  for (size_t i = 0; i < arguments.size(); ++i)
+    for (size_t j = i + 1; j < arguments.size(); ++j) {
+      if (arguments[i].first == arguments[j].first) {
+        throw SemanticError("cannot have multiple arguments with the same name");
+      }
+    }
+  store.registerName(node->getFunctionName(), std::make_unique<FunctionData>(node));
+}
+
+void SemanticAnalyzer::prepareFunction(FunctionData* function) {
+  auto definition = function->getDefinition();
+  if (!definition->isBodyPending()) {
+    return;
+  }
+  std::lock_guard<std::recursive_mutex> lock(getAnalysisMutex());
+  if (definition->isBodyPending()) {
+    analyzeFunctionBody(definition);
+    definition->setBodyPending(false);
+    runDeferredChecks(definition);
+  }
+}
+
+std::recursive_mutex& SemanticAnalyzer::getAnalysisMutex() {
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
+namespace {
+const unsigned PARALLEL_FORBIDDEN_EFFECTS = (1u << FunctionDefinitionNode::ASSIGNS_OUTER)
+                                            | (1u << FunctionDefinitionNode::PRINTS)
+                                            | (1u << FunctionDefinitionNode::READS_INPUT)
+                                            | (1u << FunctionDefinitionNode::IMPORTS)
+                                            | (1u << FunctionDefinitionNode::MODIFIES_SHARED);
+// spawned functions receive deep copies of their arguments, so modifying them is harmless
+const unsigned TASK_FORBIDDEN_EFFECTS = (1u << FunctionDefinitionNode::ASSIGNS_OUTER)
+                                        | (1u << FunctionDefinitionNode::READS_OUTER)
+                                        | (1u << FunctionDefinitionNode::READS_INPUT)
+                                        | (1u << FunctionDefinitionNode::IMPORTS);
+}
+
+void SemanticAnalyzer::analyzeFunctionBody(FunctionDefinitionNode* definition) {
+  store.newLevel();
+  for (const auto& arg : definition->getArguments()) {
+    registerVariable(arg.first, arg.second, true);
+  }
+  effectScopes.push_back({definition, store.getLevelCount() - 1,
+                          std::vector<std::string>(FunctionDefinitionNode::SIDE_EFFECT_COUNT), {}});
+  analyze(definition->getBlock().get(), true, definition->getReturnType());
+  auto scope = std::move(effectScopes.back());
+  effectScopes.pop_back();
+  definition->setEffects(std::move(scope.sideEffects), std::move(scope.callees));
+  store.deleteLevel();
+}
+
+void SemanticAnalyzer::analyzeParallelBody(ForNode* node) {
+  effectScopes.push_back({nullptr, store.getLevelCount() - 1,
+                          std::vector<std::string>(FunctionDefinitionNode::SIDE_EFFECT_COUNT), {}});
+  analyze(node->getBlock().get());
+  auto scope = std::move(effectScopes.back());
+  effectScopes.pop_back();
+  auto sideEffect = getSideEffect(scope.sideEffects, PARALLEL_FORBIDDEN_EFFECTS);
+  if (!sideEffect.empty()) {
+    throw SemanticError("parallel for body " + sideEffect);
+  }
+  std::set<FunctionDefinitionNode*> visited;
+  std::vector<FunctionDefinitionNode*> inProgress;
+  for (auto callee : scope.callees) {
+    sideEffect = findSideEffect(callee, PARALLEL_FORBIDDEN_EFFECTS, visited, inProgress);
+    if (!sideEffect.empty()) {
+      throw SemanticError("parallel for body calls " + callee->getFunctionName() + ", which " + sideEffect);
+    }
+  }
+  for (auto function : inProgress) {
+    deferredChecks.push_back({function, PARALLEL_FORBIDDEN_EFFECTS,
+                              "parallel for body calls " + function->getFunctionName() + ", which ", nullptr});
+  }
+}
+
+void SemanticAnalyzer::analyzeSpawn(SpawnNode* node) {
+  auto call = node->getCall().get();
+  analyzeExpr(call);
+  auto function = store.getFunctionData(call->getFunctionName())->getDefinition();
+  std::set<FunctionDefinitionNode*> visited;
+  std::vector<FunctionDefinitionNode*> inProgress;
+  auto sideEffect = findSideEffect(function, TASK_FORBIDDEN_EFFECTS, visited, inProgress);
+  if (!sideEffect.empty()) {
+    throw SemanticError("spawned function " + function->getFunctionName() + " " + sideEffect);
+  }
+  node->setFunctions(std::vector<FunctionDefinitionNode*>(visited.begin(), visited.end()));
+  for (auto pending : inProgress) {
+    std::string message = "spawned function " + function->getFunctionName() + " ";
+    if (pending != function) {
+      message += "calls " + pending->getFunctionName() + ", which ";
+    }
+    deferredChecks.push_back({pending, TASK_FORBIDDEN_EFFECTS, message, node});
+  }
+}
+
+void SemanticAnalyzer::recordSideEffect(FunctionDefinitionNode::SideEffect kind, const std::string& description) {
+  if (!effectScopes.empty() && effectScopes.back().sideEffects[kind].empty()) {
+    effectScopes.back().sideEffects[kind] = description;
+  }
+}
+
+// inPlace is set for add and sort; an assignment through an index modifies the indexed array in place as well
+void SemanticAnalyzer::recordAssignment(ExpressionNode* target, ExpressionNode* value, bool inPlace) {
+  while (target->getType() == Node::BINARY_OPERATOR) {
+    target = dynamic_cast<BinaryOperatorNode*>(target)->getLeftOperand().get();
+    inPlace = true;
+  }
+  if (target->getType() != Node::VARIABLE) {
+    if (inPlace && !isFreshArray(target)) {
+      recordSideEffect(FunctionDefinitionNode::MODIFIES_SHARED,
+                       "modifies an array that may share storage with an outer variable");
+    }
+    return;
+  }
+  auto name = dynamic_cast<VariableNode*>(target)->getName();
+  if (!effectScopes.empty() && store.getLevelOf(name) < effectScopes.back().boundary) {
+    recordSideEffect(FunctionDefinitionNode::ASSIGNS_OUTER, "assigns to outer variable " + name);
+    return;
+  }
+  if (isTypeArray(getExpressionType(target))) {
+    bool shared = value != nullptr && isTypeArray(getExpressionType(value)) && !isFreshArray(value);
+    recordArraySharing(name, inPlace, shared);
+  }
+}
+
+void SemanticAnalyzer::registerVariable(const std::string& name, int type, bool sharedArray) {
+  auto data = std::make_unique<VariableData>(type, nullptr);
+  modifiedArrays.erase(data.get());
+  if (isTypeArray(type) && sharedArray) {
+    sharedArrays.insert(data.get());
+  } else {
+    sharedArrays.erase(data.get());
+  }
+  store.registerName(name, std::move(data));
+}
+
+// arrays are copied by reference, so modifying a local one is only safe if its storage is not reachable from
+// anywhere else; the order of the sharing and the modification does not matter, since either may sit in a loop
+void SemanticAnalyzer::recordArraySharing(const std::string& name, bool modified, bool shared) {
+  auto variable = store.getVariableData(name);
+  if (modified) {
+    modifiedArrays.insert(variable);
+  }
+  if (shared) {
+    sharedArrays.insert(variable);
+  }
+  if (modifiedArrays.count(variable) != 0 && sharedArrays.count(variable) != 0) {
+    recordSideEffect(FunctionDefinitionNode::MODIFIES_SHARED,
+                     "modifies array " + name + ", which may share storage with an outer variable");
+  }
+}
+
+// arrays created by the expression itself, which no variable can reference yet
+bool SemanticAnalyzer::isFreshArray(ExpressionNode* node) {
+  if (node->getType() == Node::LIST_VALUE) {
+    for (const auto& element : dynamic_cast<ListValueNode*>(node)->getElements()) {
+      int type = getExpressionType(element.get());
+      if ((isTypeArray(type) || isTypeList(type)) && !isFreshArray(element.get())) {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (node->getType() == Node::FUNCTION_CALL) {
+    auto name = dynamic_cast<FunctionCallNode*>(node)->getFunctionName();
+    return name == "sorted" || name == "split" || name == "readFiles" || name == "loadNumbers";
+  }
+  return false;
+}
+
+void SemanticAnalyzer::recordVariableRead(const std::string& name) {
+  if (!effectScopes.empty() && store.getLevelOf(name) < effectScopes.back().boundary) {
+    recordSideEffect(FunctionDefinitionNode::READS_OUTER, "reads outer variable " + name);
+  }
+}
+
+std::string SemanticAnalyzer::findSideEffect(FunctionDefinitionNode* function, unsigned kinds,
+                                             std::set<FunctionDefinitionNode*>& visited,
+                                             std::vector<FunctionDefinitionNode*>& inProgress) {
+  if (!visited.insert(function).second) {
+    return "";
+  }
+  for (const auto& scope : effectScopes) {
+    if (scope.function == function) {
+      inProgress.push_back(function);
+      return "";
+    }
+  }
+  if (function->isBodyPending()) {
+    FunctionData data(function);
+    prepareFunction(&data);
+  }
+  auto sideEffect = getSideEffect(function->getSideEffects(), kinds);
+  if (!sideEffect.empty()) {
+    return sideEffect;
+  }
+  for (auto callee : function->getCallees()) {
+    sideEffect = findSideEffect(callee, kinds, visited, inProgress);
+    if (!sideEffect.empty()) {
+      return "calls " + callee->getFunctionName() + ", which " + sideEffect;
+    }
+  }
+  return "";
+}
+
+void SemanticAnalyzer::runDeferredChecks(FunctionDefinitionNode* function) {
+  std::vector<DeferredCheck> checks;
+  for (auto it = deferredChecks.begin(); it != deferredChecks.end();) {
+    if (it->function == function) {
+      checks.push_back(std::move(*it));
+      it = deferredChecks.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (const auto& check : checks) {
+    std::set<FunctionDefinitionNode*> visited;
+    std::vector<FunctionDefinitionNode*> inProgress;
+    auto sideEffect = findSideEffect(function, check.kinds, visited, inProgress);
+    if (!sideEffect.empty()) {
+      throw SemanticError(check.message + sideEffect);
+    }
+    if (check.spawn != nullptr) {
+      auto functions = check.spawn->getFunctions();
+      functions.insert(functions.end(), visited.begin(), visited.end());
+      std::sort(functions.begin(), functions.end());
+      functions.erase(std::unique(functions.begin(), functions.end()), functions.end());
+      check.spawn->setFunctions(std::move(functions));
+    }
+    for (auto pending : inProgress) {
+      deferredChecks.push_back({pending, check.kinds, check.message, check.spawn});
+    }
   }
 }
 
+std::string SemanticAnalyzer::getSideEffect(const std::vector<std::string>& sideEffects, unsigned kinds) {
+  for (size_t kind = 0; kind < sideEffects.size(); ++kind) {
+    if ((kinds >> kind & 1u) && !sideEffects[kind].empty()) {
+      return sideEffects[kind];
+    }
+  }
+  return "";
+}
+
 void SemanticAnalyzer::analyzeExpr(ExpressionNode* node) {
-  getExpressionType(node);
-  getExpressionMemoryClass(node);
+  int type = computeExpressionType(node);
+  node->annotate(type, computeExpressionMemoryClass(node));
 }
 
 int SemanticAnalyzer::getExpressionType(ExpressionNode* node) {
+  return node->getResultType();
+}
+
+Value::MemoryClass SemanticAnalyzer::getExpressionMemoryClass(ExpressionNode* node) {
+  return node->getMemoryClass();
+}
+
+int SemanticAnalyzer::computeExpressionType(ExpressionNode* node) {
   auto unOpNode = dynamic_cast<UnaryOperatorNode*>(node);
   auto binOpNode = dynamic_cast<BinaryOperatorNode*>(node);
   switch (node->getType()) {
@@ -171,15 +452,47 @@ int SemanticAnalyzer::getExpressionType(ExpressionNode* node) {
           lt = TYPE_MIXED;
         }
       }
+      if (!isTypeNestable(lt)) {
+        throw SemanticError("lists nested too deeply");
+      }
       return TYPE_LIST(lt);
     }
     case Node::UNARY_OPERATOR:
+      analyzeExpr(unOpNode->getOperand().get());
       return getResultType(unOpNode->getOperator(), getExpressionType(unOpNode->getOperand().get()));
     case Node::BINARY_OPERATOR:
+      analyzeExpr(binOpNode->getLeftOperand().get());
+      analyzeExpr(binOpNode->getRightOperand().get());
+      if (binOpNode->getOperator() >= BinaryOperatorNode::ASSIGN
+          && binOpNode->getOperator() <= BinaryOperatorNode::AND_ASSIGN) {
+        recordAssignment(binOpNode->getLeftOperand().get(), binOpNode->getRightOperand().get(), false);
+      }
       return getResultType(binOpNode->getOperator(), getExpressionType(binOpNode->getLeftOperand().get()),
           getExpressionType(binOpNode->getRightOperand().get()));
     case Node::VARIABLE:
-      return Lvalue(dynamic_cast<VariableNode*>(node)->getName()).getType();
+      recordVariableRead(dynamic_cast<VariableNode*>(node)->getName());
+      return Lvalue(store, dynamic_cast<VariableNode*>(node)->getName()).getType();
+    case Node::SPAWN: {
+      auto spawnNode = dynamic_cast<SpawnNode*>(node);
+      analyzeSpawn(spawnNode);
+      return TYPE_TASK(getExpressionType(spawnNode->getCall().get()));
+    }
+    case Node::AWAIT: {
+      auto task = dynamic_cast<AwaitNode*>(node)->getTask().get();
+      analyzeExpr(task);
+      if (!isTypeTask(getExpressionType(task))) {
+        throw SemanticError("await expects a task");
+      }
+      return getTaskResultType(getExpressionType(task));
+    }
+    case Node::CHANNEL: {
+      auto channelNode = dynamic_cast<ChannelNode*>(node);
+      analyzeExpr(channelNode->getCapacity().get());
+      if (getExpressionType(channelNode->getCapacity().get()) != TYPE_NUMBER) {
+        throw SemanticError("channel capacity should be a number");
+      }
+      return channelNode->getChannelType();
+    }
     case Node::FUNCTION_CALL: {
       auto fncNode = dynamic_cast<FunctionCallNode*>(node);
       std::string name = fncNode->getFunctionName();
@@ -246,8 +559,188 @@ int SemanticAnalyzer::getExpressionType(ExpressionNode* node) {
         if (!isTypeArray(tp0) || getArrayElementType(tp0) != tp1) {
           throw SemanticError("the arguments for add should be an array and an element of the same type");
         }
+        recordAssignment(expr0, expr1, true);
+        return TYPE_NONE;
+      }
+      if (name == "readLines" || name == "readFile") {
+        if (as != 1) {
+          throw SemanticError(name + " function accepts one argument");
+        }
+        auto expr = arguments[0].get();
+        analyzeExpr(expr);
+        if (getExpressionType(expr) != TYPE_STRING) {
+          throw SemanticError("the argument for " + name + " should be a path string");
+        }
+        return name == "readLines" ? TYPE_LINES : TYPE_STRING;
+      }
+      if (name == "readFiles") {
+        if (as != 1) {
+          throw SemanticError("readFiles function accepts one argument");
+        }
+        auto expr = arguments[0].get();
+        analyzeExpr(expr);
+        if (getExpressionType(expr) != TYPE_ARRAY(TYPE_STRING)) {
+          throw SemanticError("the argument for readFiles should be an array of path strings");
+        }
+        return TYPE_ARRAY(TYPE_STRING);
+      }
+      if (name == "loadNumbers") {
+        if (as != 1) {
+          throw SemanticError("loadNumbers function accepts one argument");
+        }
+        auto expr = arguments[0].get();
+        analyzeExpr(expr);
+        if (getExpressionType(expr) != TYPE_STRING) {
+          throw SemanticError("the argument for loadNumbers should be a path string");
+        }
+        return TYPE_ARRAY(TYPE_NUMBER);
+      }
+      if (name == "saveNumbers") {
+        if (as != 2) {
+          throw SemanticError("saveNumbers function accepts two arguments");
+        }
+        auto expr0 = arguments[0].get();
+        auto expr1 = arguments[1].get();
+        analyzeExpr(expr0);
+        analyzeExpr(expr1);
+        if (getExpressionType(expr0) != TYPE_STRING || getExpressionType(expr1) != TYPE_ARRAY(TYPE_NUMBER)) {
+          throw SemanticError("the arguments for saveNumbers should be a path string and an array of numbers");
+        }
+        return TYPE_NONE;
+      }
+      if (name == "find" || name == "contains" || name == "startsWith" || name == "split" || name == "replace" ||
+          name == "trim") {
+        int argc = name == "trim" ? 1 : name == "replace" ? 3 : 2;
+        if (as != argc) {
+          throw SemanticError(name + " function accepts " + (argc == 1 ? "one argument" :
+                                                             argc == 2 ? "two arguments" : "three arguments"));
+        }
+        for (const auto& argument : arguments) {
+          analyzeExpr(argument.get());
+          if (getExpressionType(argument.get()) != TYPE_STRING) {
+            throw SemanticError("the arguments for " + name + " should be strings");
+          }
+        }
+        if (name == "find") {
+          return TYPE_NUMBER;
+        }
+        if (name == "contains" || name == "startsWith") {
+          return TYPE_BOOLEAN;
+        }
+        return name == "split" ? TYPE_ARRAY(TYPE_STRING) : TYPE_STRING;
+      }
+      if (name == "send") {
+        if (as != 2) {
+          throw SemanticError("send function accepts two arguments");
+        }
+        auto expr0 = arguments[0].get();
+        auto expr1 = arguments[1].get();
+        analyzeExpr(expr0);
+        analyzeExpr(expr1);
+        int tp0 = getExpressionType(expr0);
+        if (!isTypeChannel(tp0) || getChannelElementType(tp0) != getExpressionType(expr1)) {
+          throw SemanticError("the arguments for send should be a channel and an element of the same type");
+        }
+        return TYPE_NONE;
+      }
+      if (name == "openWrite") {
+        if (as != 1) {
+          throw SemanticError("openWrite function accepts one argument");
+        }
+        auto expr = arguments[0].get();
+        analyzeExpr(expr);
+        if (getExpressionType(expr) != TYPE_STRING) {
+          throw SemanticError("the argument for openWrite should be a path string");
+        }
+        return TYPE_WRITER;
+      }
+      if (name == "write" || name == "writeLine") {
+        if (as != 2) {
+          throw SemanticError(name + " function accepts two arguments");
+        }
+        auto expr0 = arguments[0].get();
+        auto expr1 = arguments[1].get();
+        analyzeExpr(expr0);
+        analyzeExpr(expr1);
+        int tp1 = getExpressionType(expr1);
+        if (getExpressionType(expr0) != TYPE_WRITER ||
+            (tp1 != TYPE_BOOLEAN && tp1 != TYPE_NUMBER && tp1 != TYPE_STRING)) {
+          throw SemanticError("the arguments for " + name + " should be a file writer and a primitive value");
+        }
         return TYPE_NONE;
       }
+      if (name == "receive" || name == "close") {
+        if (as != 1) {
+          throw SemanticError(name + " function accepts one argument");
+        }
+        auto expr = arguments[0].get();
+        analyzeExpr(expr);
+        int tp = getExpressionType(expr);
+        if (name == "close" && tp == TYPE_WRITER) {
+          return TYPE_NONE;
+        }
+        if (!isTypeChannel(tp)) {
+          throw SemanticError(name == "close" ? "the argument for close should be a channel or a file writer"
+                                              : "the argument for receive should be a channel");
+        }
+        return name == "receive" ? getChannelElementType(tp) : TYPE_NONE;
+      }
+      if (name == "sort" || name == "sorted") {
+        if (as != 1) {
+          throw SemanticError(name + " function accepts one argument");
+        }
+        auto expr = arguments[0].get();
+        analyzeExpr(expr);
+        int tp = getExpressionType(expr);
+        if (tp != TYPE_ARRAY(TYPE_NUMBER) && tp != TYPE_ARRAY(TYPE_STRING)) {
+          throw SemanticError("the argument for " + name + " should be an array of numbers or strings");
+        }
+        if (name == "sort") {
+          recordAssignment(expr, nullptr, true);
+          return TYPE_NONE;
+        }
+        return tp;
+      }
+      if (name == "binarySearch") {
+        if (as != 2) {
+          throw SemanticError("binarySearch function accepts two arguments");
+        }
+        auto expr0 = arguments[0].get();
+        auto expr1 = arguments[1].get();
+        analyzeExpr(expr0);
+        analyzeExpr(expr1);
+        int tp0 = getExpressionType(expr0);
+        int tp1 = getExpressionType(expr1);
+        if ((tp0 != TYPE_ARRAY(TYPE_NUMBER) && tp0 != TYPE_ARRAY(TYPE_STRING)) || getArrayElementType(tp0) != tp1) {
+          throw SemanticError("the arguments for binarySearch should be an array of numbers or strings and an element");
+        }
+        return TYPE_NUMBER;
+      }
+      if (name == "sum" || name == "min" || name == "max" || name == "mean") {
+        if (as != 1) {
+          throw SemanticError(name + " function accepts one argument");
+        }
+        auto expr = arguments[0].get();
+        analyzeExpr(expr);
+        if (getExpressionType(expr) != TYPE_ARRAY(TYPE_NUMBER)) {
+          throw SemanticError("the argument for " + name + " should be an array of numbers");
+        }
+        return TYPE_NUMBER;
+      }
+      if (name == "dot") {
+        if (as != 2) {
+          throw SemanticError("dot function accepts two arguments");
+        }
+        auto expr0 = arguments[0].get();
+        auto expr1 = arguments[1].get();
+        analyzeExpr(expr0);
+        analyzeExpr(expr1);
+        if (getExpressionType(expr0) != TYPE_ARRAY(TYPE_NUMBER) ||
+            getExpressionType(expr1) != TYPE_ARRAY(TYPE_NUMBER)) {
+          throw SemanticError("the arguments for dot should be arrays of numbers");
+        }
+        return TYPE_NUMBER;
+      }
       auto fncData = store.getFunctionData(name);
       int argc = fncData->getArguments().size();
       if (as != argc) {
@@ -261,6 +754,9 @@ int SemanticAnalyzer::getExpressionType(ExpressionNode* node) {
           throw SemanticError("argument type does not match");
         }
       }
+      if (!effectScopes.empty()) {
+        effectScopes.back().callees.push_back(fncData->getDefinition());
+      }
       return fncData->getReturnType();
     }
     default:
@@ -268,7 +764,7 @@ int SemanticAnalyzer::getExpressionType(ExpressionNode* node) {
   }
 }
 
-Value::MemoryClass SemanticAnalyzer::getExpressionMemoryClass(ExpressionNode* node) {
+Value::MemoryClass SemanticAnalyzer::computeExpressionMemoryClass(ExpressionNode* node) {
   auto unOpNode = dynamic_cast<UnaryOperatorNode*>(node);
   auto binOpNode = dynamic_cast<BinaryOperatorNode*>(node);
   switch (node->getType()) {
@@ -283,10 +779,8 @@ Value::MemoryClass SemanticAnalyzer::getExpressionMemoryClass(ExpressionNode* no
           getExpressionMemoryClass(binOpNode->getRightOperand().get()));
     case Node::VARIABLE:
       return Value::LVALUE;
-    case Node::FUNCTION_CALL:
-      return Value::RVALUE;
     default:
-      break;
+      return Value::RVALUE;
   }
 }
 
@@ -319,7 +813,8 @@ int SemanticAnalyzer::getResultType(BinaryOperatorNode::BinaryOperator op, int l
       if (lhs == TYPE_BOOLEAN && rhs == TYPE_BOOLEAN) return TYPE_BOOLEAN;
       if (lhs == TYPE_NUMBER && rhs == TYPE_NUMBER) return TYPE_NUMBER;
       if (lhs == TYPE_STRING && rhs == TYPE_STRING) return TYPE_STRING;
-      if (isTypeArray(lhs) && rhs == lhs) return lhs;
+      if ((isTypeArray(lhs) || isTypeTask(lhs) || isTypeChannel(lhs) || lhs == TYPE_LINES || lhs == TYPE_WRITER) &&
+          rhs == lhs) return lhs;
       if (isTypeArray(lhs) && isTypeList(rhs)
           && (getArrayElementType(lhs) == getListElementType(rhs) || getListElementType(rhs) == TYPE_NONE)) {
         return lhs;
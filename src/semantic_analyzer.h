@@ -1,23 +1,76 @@
 #ifndef PROG_LANG_SEMANTIC_ANALYZER_H
 #define PROG_LANG_SEMANTIC_ANALYZER_H
 
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "node.h"
 #include "types.h"
 #include "value.h"
 
+class Context;
+class FunctionData;
+class Store;
+class VariableData;
+
 class SemanticAnalyzer {
  public:
-  static void analyze(Node* node, bool allowReturn = false, int retType = TYPE_NONE);
+  explicit SemanticAnalyzer(Context& context);
+  void analyze(Node* node, bool allowReturn = false, int retType = TYPE_NONE);
+  void registerFunction(FunctionDefinitionNode* node);
+  void prepareFunction(FunctionData* function);
+  static std::recursive_mutex& getAnalysisMutex();
 
  private:
-  static void analyzeExpr(ExpressionNode* node);
+  struct EffectScope {
+    FunctionDefinitionNode* function;
+    int boundary;
+    std::vector<std::string> sideEffects;
+    std::vector<FunctionDefinitionNode*> callees;
+  };
+
+  // side effect checks that involve a function whose body is still being analyzed
+  struct DeferredCheck {
+    FunctionDefinitionNode* function;
+    unsigned kinds;
+    std::string message;
+    SpawnNode* spawn;
+  };
+
+  void analyzeFunctionBody(FunctionDefinitionNode* definition);
+  void analyzeParallelBody(ForNode* node);
+  void analyzeSpawn(SpawnNode* node);
+  void recordSideEffect(FunctionDefinitionNode::SideEffect kind, const std::string& description);
+  void recordAssignment(ExpressionNode* target, ExpressionNode* value, bool inPlace);
+  void registerVariable(const std::string& name, int type, bool sharedArray);
+  void recordArraySharing(const std::string& name, bool modified, bool shared);
+  static bool isFreshArray(ExpressionNode* node);
+  void recordVariableRead(const std::string& name);
+  std::string findSideEffect(FunctionDefinitionNode* function, unsigned kinds,
+                             std::set<FunctionDefinitionNode*>& visited,
+                             std::vector<FunctionDefinitionNode*>& inProgress);
+  void runDeferredChecks(FunctionDefinitionNode* function);
+  static std::string getSideEffect(const std::vector<std::string>& sideEffects, unsigned kinds);
+  void analyzeExpr(ExpressionNode* node);
   static int getExpressionType(ExpressionNode* node);
   static Value::MemoryClass getExpressionMemoryClass(ExpressionNode* node);
+  int computeExpressionType(ExpressionNode* node);
+  static Value::MemoryClass computeExpressionMemoryClass(ExpressionNode* node);
   static int getResultType(UnaryOperatorNode::UnaryOperator op, int type);
   static int getResultType(BinaryOperatorNode::BinaryOperator op, int lhs, int rhs);
   static Value::MemoryClass getMemoryClass(UnaryOperatorNode::UnaryOperator op, Value::MemoryClass cls);
   static Value::MemoryClass getMemoryClass(BinaryOperatorNode::BinaryOperator op, Value::MemoryClass lhs,
                                            Value::MemoryClass rhs);
+
+  Context& context;
+  Store& store;
+  std::vector<EffectScope> effectScopes;
+  std::vector<DeferredCheck> deferredChecks;
+  // local arrays that may share storage with other variables, and local arrays that are modified in place
+  std::set<const VariableData*> sharedArrays;
+  std::set<const VariableData*> modifiedArrays;
 };
 
 #endif //PROG_LANG_SEMANTIC_ANALYZER_H
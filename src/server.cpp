@@ -0,0 +1,299 @@
+#include "server.h"
+
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "error.h"
+
+namespace {
+const int BACKLOG = 64;
+// request fields come from any client that can reach the socket, so their sizes are checked before allocating
+const uint64_t MAX_NAME_SIZE = 4096;
+const uint64_t MAX_TEXT_SIZE = uint64_t(64) << 20;
+const uint64_t MAX_ARGUMENTS = 4096;
+// a client that stops sending in the middle of a request is dropped instead of holding a worker
+const int REQUEST_TIMEOUT_SECONDS = 10;
+
+[[noreturn]] void throwSystemError(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+sockaddr_un makeAddress(const std::string& socketPath) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (socketPath.size() >= sizeof(address.sun_path)) {
+    throw std::system_error(std::make_error_code(std::errc::filename_too_long), socketPath);
+  }
+  std::strcpy(address.sun_path, socketPath.c_str());
+  return address;
+}
+
+void setRequestTimeout(int connection) {
+  timeval timeout{};
+  timeout.tv_sec = REQUEST_TIMEOUT_SECONDS;
+  setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+void writeBytes(int fd, const char* data, size_t size) {
+  while (size > 0) {
+    ssize_t written = write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwSystemError("write");
+    }
+    data += written;
+    size -= written;
+  }
+}
+
+void readBytes(int fd, char* data, size_t size) {
+  while (size > 0) {
+    ssize_t count = read(fd, data, size);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count < 0) {
+      throwSystemError("read");
+    }
+    if (count == 0) {
+      throw std::system_error(std::make_error_code(std::errc::connection_aborted), "read");
+    }
+    data += count;
+    size -= count;
+  }
+}
+
+void writeNumber(int fd, uint64_t value) { writeBytes(fd, reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+uint64_t readNumber(int fd) {
+  uint64_t value;
+  readBytes(fd, reinterpret_cast<char*>(&value), sizeof(value));
+  return value;
+}
+
+void writeString(int fd, const std::string& value) {
+  writeNumber(fd, value.size());
+  writeBytes(fd, value.data(), value.size());
+}
+
+uint64_t readSize(int fd, uint64_t maxSize) {
+  uint64_t size = readNumber(fd);
+  if (size > maxSize) {
+    throw std::length_error("request field of " + std::to_string(size) + " exceeds the limit of "
+                            + std::to_string(maxSize));
+  }
+  return size;
+}
+
+std::string readString(int fd, uint64_t maxSize = std::numeric_limits<uint64_t>::max()) {
+  std::string value(readSize(fd, maxSize), '\0');
+  readBytes(fd, &value[0], value.size());
+  return value;
+}
+}
+
+Server::Server(std::string socketPath, unsigned jobs, size_t cacheSize, bool lazyFunctionAnalysis, bool forking,
+               std::vector<std::string> preload)
+    : socketPath(std::move(socketPath)), jobs(jobs), cache(cacheSize, lazyFunctionAnalysis), forking(forking),
+      preload(std::move(preload)) {}
+
+void Server::run() {
+  std::signal(SIGPIPE, SIG_IGN);
+  auto address = makeAddress(socketPath);
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listener < 0) {
+    throwSystemError("socket");
+  }
+  unlink(socketPath.c_str());
+  if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+    throwSystemError("bind " + socketPath);
+  }
+  if (listen(listener, BACKLOG) < 0) {
+    throwSystemError("listen");
+  }
+  if (forking) {
+    forkLoop(listener);
+  }
+  for (unsigned i = 0; i < jobs; ++i) {
+    std::thread(&Server::workerLoop, this).detach();
+  }
+  while (true) {
+    int connection = accept(listener, nullptr, nullptr);
+    if (connection < 0) {
+      continue;
+    }
+    setRequestTimeout(connection);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      connections.push(connection);
+    }
+    condition.notify_one();
+  }
+}
+
+void Server::workerLoop() {
+  while (true) {
+    int connection;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [this]() { return !connections.empty(); });
+      connection = connections.front();
+      connections.pop();
+    }
+    try {
+      handle(connection);
+    } catch (std::exception&) {
+      // the client went away; nothing left to report to
+    }
+    close(connection);
+  }
+}
+
+void Server::forkLoop(int listener) {
+  // the lexer and parser tables are built on first use, so they are built here once instead of in every child
+  Program::compileSource("warmUp := 0", "<warm-up>");
+  for (const auto& fileName : preload) {
+    Request request{fileName, "", "", {}};
+    try {
+      getProgram(request);
+    } catch (Error& e) {
+      std::cout << fileName << ": " << e.toString() << "\n";
+    } catch (std::exception& e) {
+      std::cout << fileName << ": Error: " << e.what() << "\n";
+    }
+  }
+  unsigned running = 0;
+  while (true) {
+    int connection = accept(listener, nullptr, nullptr);
+    if (connection < 0) {
+      continue;
+    }
+    setRequestTimeout(connection);
+    while (running > 0 && waitpid(-1, nullptr, running < jobs ? WNOHANG : 0) > 0) {
+      --running;
+    }
+    running += runForked(listener, connection) ? 1 : 0;
+    close(connection);
+  }
+}
+
+void Server::handle(int connection) {
+  Request request;
+  try {
+    request = readRequest(connection);
+  } catch (std::length_error& e) {
+    respond(connection, "", std::string("Error: ") + e.what());
+    return;
+  }
+  std::istringstream input(request.input);
+  std::ostringstream output;
+  std::string error;
+  try {
+    getProgram(request)->run(input, output, request.arguments);
+  } catch (Error& e) {
+    error = e.toString();
+  } catch (std::exception& e) {
+    error = std::string("Error: ") + e.what();
+  }
+  respond(connection, output.str(), error);
+}
+
+bool Server::runForked(int listener, int connection) {
+  // the child reads and compiles the request itself, so a slow client or a long compilation only holds up its own job
+  pid_t pid = fork();
+  if (pid < 0) {
+    try {
+      respond(connection, "", std::string("Error: fork: ") + std::strerror(errno));
+    } catch (std::exception&) {
+    }
+    return false;
+  }
+  if (pid > 0) {
+    return true;
+  }
+  close(listener);
+  try {
+    handle(connection);
+  } catch (std::exception&) {
+    // the client went away; nothing left to report to
+  }
+  _exit(0);
+}
+
+std::shared_ptr<const Program> Server::getProgram(Request& request) {
+  if (request.source.empty()) {
+    std::ifstream file(request.fileName);
+    if (!file) {
+      throw std::runtime_error("can not open source file " + request.fileName);
+    }
+    request.source.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  }
+  return cache.get(request.fileName, request.source);
+}
+
+Server::Request Server::readRequest(int connection) {
+  Request request;
+  request.fileName = readString(connection, MAX_NAME_SIZE);
+  request.source = readString(connection, MAX_TEXT_SIZE);
+  request.input = readString(connection, MAX_TEXT_SIZE);
+  request.arguments.resize(readSize(connection, MAX_ARGUMENTS));
+  for (auto& argument : request.arguments) {
+    argument = readString(connection, MAX_NAME_SIZE);
+  }
+  return request;
+}
+
+void Server::respond(int connection, const std::string& output, const std::string& error) {
+  char status = error.empty() ? 0 : 1;
+  writeBytes(connection, &status, 1);
+  writeString(connection, output);
+  writeString(connection, error);
+}
+
+void Server::forward(const std::string& socketPath, const std::string& fileName,
+                     const std::vector<std::string>& arguments, std::istream& input, std::ostream& output) {
+  auto address = makeAddress(socketPath);
+  int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (connection < 0) {
+    throwSystemError("socket");
+  }
+  if (connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+    close(connection);
+    throwSystemError("connect " + socketPath);
+  }
+  try {
+    writeString(connection, fileName);
+    writeString(connection, "");
+    writeString(connection, std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()));
+    writeNumber(connection, arguments.size());
+    for (const auto& argument : arguments) {
+      writeString(connection, argument);
+    }
+    char status;
+    readBytes(connection, &status, 1);
+    output << readString(connection);
+    auto error = readString(connection);
+    if (status != 0) {
+      output << error << "\n";
+    }
+  } catch (...) {
+    close(connection);
+    throw;
+  }
+  close(connection);
+}
@@ -0,0 +1,53 @@
+#ifndef PROG_LANG_SERVER_H
+#define PROG_LANG_SERVER_H
+
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "program_cache.h"
+
+// Runs scripts for clients connected to a Unix domain socket.
+// Request: file name, source (read from the file name when empty), input, arguments.
+// Response: status (0 on success), output, error message.
+// In forking mode the single-threaded parent only accepts connections, and every request is read, compiled and run in
+// a child forked from it, so each script starts with the program cache warmed by the preloaded files but can not
+// affect the server or other jobs
+class Server {
+ public:
+  Server(std::string socketPath, unsigned jobs, size_t cacheSize, bool lazyFunctionAnalysis, bool forking = false,
+         std::vector<std::string> preload = {});
+  [[noreturn]] void run();
+  static void forward(const std::string& socketPath, const std::string& fileName,
+                      const std::vector<std::string>& arguments, std::istream& input, std::ostream& output);
+
+ private:
+  struct Request {
+    std::string fileName;
+    std::string source;
+    std::string input;
+    std::vector<std::string> arguments;
+  };
+
+  void workerLoop();
+  [[noreturn]] void forkLoop(int listener);
+  void handle(int connection);
+  bool runForked(int listener, int connection);
+  std::shared_ptr<const Program> getProgram(Request& request);
+  static Request readRequest(int connection);
+  static void respond(int connection, const std::string& output, const std::string& error);
+
+  std::string socketPath;
+  unsigned jobs;
+  ProgramCache cache;
+  bool forking;
+  std::vector<std::string> preload;
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::queue<int> connections;
+};
+
+#endif //PROG_LANG_SERVER_H
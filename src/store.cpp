@@ -1,6 +1,31 @@
 #include "store.h"
 
 #include "semantic_error.h"
+#include "vm.h"
+
+VariableData::VariableData(int type, std::unique_ptr<Value> value) {
+  if (value && value->getMemoryClass() == Value::RVALUE) {
+    this->value.reset(static_cast<Rvalue*>(value.release()));
+  } else if (value) {
+    this->value = VirtualMachine::copyRvalue(value->getRvalue());
+  } else if (type == TYPE_BOOLEAN) {
+    this->value = std::make_unique<BooleanRvalue>(false);
+  } else if (type == TYPE_NUMBER) {
+    this->value = std::make_unique<NumberRvalue>(0.0);
+  } else if (type == TYPE_STRING) {
+    this->value = std::make_unique<StringRvalue>(std::string());
+  } else if (isTypeArray(type)) {
+    this->value = std::make_unique<ArrayRvalue>(type);
+  } else if (isTypeTask(type)) {
+    this->value = std::make_unique<TaskRvalue>(type, nullptr);
+  } else if (isTypeChannel(type)) {
+    this->value = std::make_unique<ChannelRvalue>(type, nullptr);
+  } else if (type == TYPE_LINES) {
+    this->value = std::make_unique<LinesRvalue>(nullptr);
+  } else if (type == TYPE_WRITER) {
+    this->value = std::make_unique<WriterRvalue>(nullptr);
+  }
+}
 
 void StackLevel::registerName(const std::string& name, std::unique_ptr<ObjectData> objectData) {
   if (names.count(name) > 0) {
@@ -13,9 +38,26 @@ ObjectData* StackLevel::lookupName(const std::string& name) const {
   if (names.count(name) == 1) {
     return names.at(name).get();
   }
+  for (const auto& level : imports) {
+    ObjectData* data = level->lookupName(name);
+    if (data != nullptr) {
+      return data;
+    }
+  }
   return nullptr;
 }
 
+void StackLevel::addImport(std::shared_ptr<StackLevel> level) {
+  for (const auto& it : imports) {
+    if (it == level) {
+      return;
+    }
+  }
+  imports.push_back(std::move(level));
+}
+
+Store::Store(const Store* parent) : parent(parent) {}
+
 void Store::registerName(const std::string& name, std::unique_ptr<ObjectData> objectData) {
   stk.back().registerName(name, std::move(objectData));
 }
@@ -45,10 +87,41 @@ void Store::setValue(const std::string& name, std::vector<int> index, std::uniqu
   (*dynamic_cast<ArrayRvalue*>(rv)->getValue())[last] = std::move(value);
 }
 
+int Store::getLevelCount() const { return static_cast<int>(stk.size()); }
+
+int Store::getLevelOf(const std::string& name) const {
+  for (int i = static_cast<int>(stk.size()) - 1; i >= 0; --i) {
+    if (stk[i].lookupName(name) != nullptr) {
+      return i;
+    }
+  }
+  return -1;
+}
+
 void Store::newLevel() { stk.emplace_back(); }
 
 void Store::deleteLevel() { stk.pop_back(); }
 
+void Store::reset() {
+  stk.clear();
+  suspended.clear();
+}
+
+void Store::importLevel(std::shared_ptr<StackLevel> level) { stk.back().addImport(std::move(level)); }
+
+void Store::enterModule() {
+  suspended.push_back(std::move(stk));
+  stk.clear();
+  stk.emplace_back();
+}
+
+std::shared_ptr<StackLevel> Store::exitModule() {
+  auto level = std::make_shared<StackLevel>(std::move(stk.back()));
+  stk = std::move(suspended.back());
+  suspended.pop_back();
+  return level;
+}
+
 VariableData* Store::getVariableData(const std::string& name) const {
   auto data = getObjectData(name);
   if (data->getType() != ObjectData::VARIABLE) {
@@ -72,7 +145,8 @@ ObjectData* Store::getObjectData(const std::string& name) const {
       return data;
     }
   }
+  if (parent != nullptr) {
+    return parent->getObjectData(name);
+  }
   throw SemanticError(name + " is undefined in this context");
 }
-
-Store store;
@@ -18,27 +18,14 @@ class ObjectData {
     FUNCTION
   };
 
+  virtual ~ObjectData() = default;
   virtual Type getType() const = 0;
 };
 
 class VariableData : public ObjectData {
  public:
-  VariableData(int type, std::unique_ptr<Value> value) : value() {
-    const auto v = value ? value->getRvalue() : nullptr;
-    if (type == TYPE_BOOLEAN) {
-      this->value = std::make_unique<BooleanRvalue>(value ? dynamic_cast<const BooleanRvalue*>(v)->getValue() : false);
-    } else if (type == TYPE_NUMBER) {
-      this->value = std::make_unique<NumberRvalue>(value ? dynamic_cast<const NumberRvalue*>(v)->getValue() : 0.0);
-    } else if (type == TYPE_STRING) {
-      this->value = std::make_unique<StringRvalue>(
-          value ? dynamic_cast<const StringRvalue*>(v)->getValue() : std::string());
-    } else if (isTypeArray(type)) {
-      this->value = value ? std::make_unique<ArrayRvalue>(*dynamic_cast<const ArrayRvalue*>(v))
-                          : std::make_unique<ArrayRvalue>(type);
-    } else if (isTypeObj(type)) {
-
-    }
-  }
+  // without a value the variable holds the default of its type
+  VariableData(int type, std::unique_ptr<Value> value);
 
   Type getType() const override { return VARIABLE; }
 
@@ -52,48 +39,56 @@ class VariableData : public ObjectData {
 
 class FunctionData : public ObjectData {
  public:
-  FunctionData(std::vector<std::pair<std::string, int>> arguments, int retType, std::shared_ptr<BlockNode> block)
-      : arguments(std::move(arguments)), retType(retType), block(std::move(block)) {}
+  explicit FunctionData(FunctionDefinitionNode* definition) : definition(definition) {}
 
   Type getType() const override { return FUNCTION; }
 
-  const std::vector<std::pair<std::string, int>>& getArguments() { return arguments; }
+  const std::vector<std::pair<std::string, int>>& getArguments() { return definition->getArguments(); }
 
-  int getReturnType() { return retType; }
+  int getReturnType() { return definition->getReturnType(); }
 
-  const std::shared_ptr<BlockNode>& getBlock() { return block; }
+  const std::shared_ptr<BlockNode>& getBlock() { return definition->getBlock(); }
+
+  FunctionDefinitionNode* getDefinition() { return definition; }
 
  private:
-  std::vector<std::pair<std::string, int>> arguments;
-  int retType;
-  std::shared_ptr<BlockNode> block;
+  FunctionDefinitionNode* definition;
 };
 
 class StackLevel {
  public:
   void registerName(const std::string& name, std::unique_ptr<ObjectData> objectData);
   ObjectData* lookupName(const std::string& name) const;
+  void addImport(std::shared_ptr<StackLevel> level);
 
  private:
   std::map<std::string, std::unique_ptr<ObjectData>> names;
+  std::vector<std::shared_ptr<StackLevel>> imports;
 };
 
 class Store {
  public:
+  explicit Store(const Store* parent = nullptr);
   void registerName(const std::string& name, std::unique_ptr<ObjectData> objectData);
   const std::unique_ptr<Rvalue>& getValue(const std::string& name) const;
   void setValue(const std::string& name, std::unique_ptr<Rvalue> value);
   void setValue(const std::string& name, std::vector<int> index, std::unique_ptr<Rvalue> value);
   void newLevel();
   FunctionData* getFunctionData(const std::string& name) const;
+  int getLevelCount() const;
+  int getLevelOf(const std::string& name) const;
 
   void deleteLevel();
- private:
+  void reset();
+  void importLevel(std::shared_ptr<StackLevel> level);
+  void enterModule();
+  std::shared_ptr<StackLevel> exitModule();
   VariableData* getVariableData(const std::string& name) const;
+ private:
   ObjectData* getObjectData(const std::string& name) const;
   std::vector<StackLevel> stk;
+  std::vector<std::vector<StackLevel>> suspended;
+  const Store* parent;
 };
 
-extern Store store;
-
 #endif //PROG_LANG_STORE_H
@@ -0,0 +1,85 @@
+#include "string_kernels.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PROG_LANG_X86
+#endif
+
+namespace {
+bool isSpace(char c) { return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f'; }
+
+size_t findScalar(const char* data, size_t size, const char* pattern, size_t patternSize) {
+  if (patternSize > size) {
+    return size;
+  }
+  const char* last = data + size - patternSize;
+  for (const char* it = data; it <= last; ++it) {
+    it = static_cast<const char*>(std::memchr(it, pattern[0], last - it + 1));
+    if (it == nullptr) {
+      break;
+    }
+    if (std::memcmp(it + 1, pattern + 1, patternSize - 1) == 0) {
+      return it - data;
+    }
+  }
+  return size;
+}
+
+#ifdef PROG_LANG_X86
+// compares the first and the last byte of the pattern against 32 positions at once and verifies only the candidates
+__attribute__((target("avx2"))) size_t findAvx2(const char* data, size_t size, const char* pattern,
+                                                size_t patternSize) {
+  const __m256i first = _mm256_set1_epi8(pattern[0]);
+  const __m256i last = _mm256_set1_epi8(pattern[patternSize - 1]);
+  size_t i = 0;
+  for (; i + patternSize - 1 + 32 <= size; i += 32) {
+    __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+    __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + patternSize - 1));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last))));
+    while (mask != 0) {
+      size_t offset = i + __builtin_ctz(mask);
+      if (patternSize <= 2 || std::memcmp(data + offset + 1, pattern + 1, patternSize - 2) == 0) {
+        return offset;
+      }
+      mask &= mask - 1;
+    }
+  }
+  size_t rest = findScalar(data + i, size - i, pattern, patternSize);
+  return rest == size - i ? size : i + rest;
+}
+#endif
+}
+
+size_t StringKernels::find(const char* data, size_t size, const char* pattern, size_t patternSize) {
+  if (patternSize == 0) {
+    return 0;
+  }
+#ifdef PROG_LANG_X86
+  if (hasAvx2()) {
+    return findAvx2(data, size, pattern, patternSize);
+  }
+#endif
+  return findScalar(data, size, pattern, patternSize);
+}
+
+void StringKernels::trim(const char*& first, const char*& last) {
+  while (first != last && isSpace(*first)) {
+    ++first;
+  }
+  while (last != first && isSpace(last[-1])) {
+    --last;
+  }
+}
+
+bool StringKernels::hasAvx2() {
+#ifdef PROG_LANG_X86
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+#else
+  return false;
+#endif
+}
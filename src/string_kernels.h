@@ -0,0 +1,17 @@
+#ifndef PROG_LANG_STRING_KERNELS_H
+#define PROG_LANG_STRING_KERNELS_H
+
+#include <cstddef>
+
+// Byte searches over strings; AVX2 versions are picked at runtime when the CPU supports them
+class StringKernels {
+ public:
+  // returns the offset of the first occurrence of pattern in data, or size when there is none
+  static size_t find(const char* data, size_t size, const char* pattern, size_t patternSize);
+  static void trim(const char*& first, const char*& last);
+
+ private:
+  static bool hasAvx2();
+};
+
+#endif //PROG_LANG_STRING_KERNELS_H
@@ -0,0 +1,37 @@
+#include "task.h"
+
+Task::Task(Body body) : body(std::move(body)), state(PENDING), awaited(false) {}
+
+void Task::run() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (state != PENDING) {
+      return;
+    }
+    state = RUNNING;
+  }
+  try {
+    result = body(output);
+  } catch (...) {
+    error = std::current_exception();
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  body = nullptr;
+  state = FINISHED;
+  finished.notify_all();
+}
+
+void Task::await(std::ostream& output) {
+  run();
+  std::unique_lock<std::mutex> lock(mutex);
+  finished.wait(lock, [this]() { return state == FINISHED; });
+  if (!awaited) {
+    awaited = true;
+    output << this->output.str();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+const std::unique_ptr<Rvalue>& Task::getResult() const { return result; }
@@ -0,0 +1,40 @@
+#ifndef PROG_LANG_TASK_H
+#define PROG_LANG_TASK_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#include "value.h"
+
+// A spawned function call; it runs on the thread pool or, if nobody picked it up yet, on the first thread awaiting it
+class Task {
+ public:
+  typedef std::function<std::unique_ptr<Rvalue>(std::ostream& output)> Body;
+
+  explicit Task(Body body);
+  void run();
+  void await(std::ostream& output);
+  const std::unique_ptr<Rvalue>& getResult() const;
+
+ private:
+  enum State {
+    PENDING,
+    RUNNING,
+    FINISHED
+  };
+
+  Body body;
+  std::mutex mutex;
+  std::condition_variable finished;
+  State state;
+  bool awaited;
+  std::ostringstream output;
+  std::unique_ptr<Rvalue> result;
+  std::exception_ptr error;
+};
+
+#endif //PROG_LANG_TASK_H
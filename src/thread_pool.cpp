@@ -0,0 +1,195 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace {
+const size_t CHUNKS_PER_THREAD = 4;
+
+thread_local bool insideTask = false;
+}
+
+ThreadPool& ThreadPool::getInstance() {
+  static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+  return pool;
+}
+
+ThreadPool::ThreadPool(unsigned workers)
+    : pending(0), nextQueue(0), size(workers + 1), idle(0), blocked(0), spare(0), stopping(false) {
+  for (unsigned i = 0; i < std::max(workers, 1u); ++i) {
+    queues.push_back(std::make_unique<Queue>());
+  }
+  for (unsigned i = 0; i < workers; ++i) {
+    threads.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  condition.notify_all();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+unsigned ThreadPool::getSize() const { return size; }
+
+void ThreadPool::parallelFor(size_t count, const std::function<void(size_t, size_t)>& body) {
+  size_t chunks = std::min(count, getSize() * CHUNKS_PER_THREAD);
+  // tasks that wait for other tasks could exhaust the workers, so nested loops run on the calling thread
+  if (size == 1 || insideTask || chunks <= 1) {
+    if (count > 0) {
+      body(0, count);
+    }
+    return;
+  }
+  struct Batch {
+    std::atomic<size_t> remaining;
+    std::mutex mutex;
+    std::exception_ptr error;
+  };
+  auto batch = std::make_shared<Batch>();
+  batch->remaining = chunks;
+  // counted before they are queued, so that a worker taking one early never sees the counter below the queue size
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pending += chunks;
+  }
+  for (size_t i = 0; i < chunks; ++i) {
+    size_t begin = count * i / chunks;
+    size_t end = count * (i + 1) / chunks;
+    auto task = [this, batch, &body, begin, end]() {
+      try {
+        body(begin, end);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(batch->mutex);
+        if (!batch->error) {
+          batch->error = std::current_exception();
+        }
+      }
+      if (--batch->remaining == 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        condition.notify_all();
+      }
+    };
+    auto& queue = *queues[i % queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  condition.notify_all();
+  while (batch->remaining > 0) {
+    if (!runPendingTask(0)) {
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [&]() { return batch->remaining == 0 || pending > 0; });
+    }
+  }
+  if (batch->error) {
+    std::rethrow_exception(batch->error);
+  }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++pending;
+  }
+  {
+    auto& queue = *queues[nextQueue++ % queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (blocked > 0 && idle == 0) {
+      addWorker();
+    }
+  }
+  condition.notify_one();
+}
+
+void ThreadPool::block(const std::function<void()>& wait) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++blocked;
+    if (pending > 0 && idle == 0) {
+      addWorker();
+    }
+  }
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    --blocked;
+  }
+  // wakes the idle spare workers so that the ones no longer needed retire
+  condition.notify_all();
+}
+
+void ThreadPool::addWorker() {
+  // one spare per blocked thread keeps a runnable thread for the queued tasks, so more would only add contention
+  if (stopping || spare >= blocked) {
+    return;
+  }
+  ++spare;
+  if (retired.empty()) {
+    threads.emplace_back(&ThreadPool::workerLoop, this, static_cast<unsigned>(threads.size()));
+    return;
+  }
+  unsigned index = retired.back();
+  retired.pop_back();
+  // the retired worker has already released the mutex on its way out, so the join does not wait on us
+  threads[index].join();
+  threads[index] = std::thread(&ThreadPool::workerLoop, this, index);
+}
+
+bool ThreadPool::isSurplus(unsigned index) const { return index >= size - 1 && spare > blocked; }
+
+void ThreadPool::workerLoop(unsigned index) {
+  insideTask = true;
+  while (true) {
+    if (runPendingTask(index)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    if (pending == 0 && isSurplus(index)) {
+      --spare;
+      retired.push_back(index);
+      return;
+    }
+    ++idle;
+    condition.wait(lock, [this, index]() { return stopping || pending > 0 || isSurplus(index); });
+    --idle;
+    if (stopping && pending == 0) {
+      return;
+    }
+  }
+}
+
+bool ThreadPool::runPendingTask(unsigned index) {
+  std::function<void()> task;
+  for (size_t i = 0; i < queues.size() && !task; ++i) {
+    auto& queue = *queues[(index + i) % queues.size()];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+  }
+  if (!task) {
+    return false;
+  }
+  --pending;
+  bool nested = insideTask;
+  insideTask = true;
+  task();
+  insideTask = nested;
+  return true;
+}
@@ -0,0 +1,56 @@
+#ifndef PROG_LANG_THREAD_POOL_H
+#define PROG_LANG_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool: every worker owns a deque of tasks and steals from the others when its own runs dry
+class ThreadPool {
+ public:
+  static ThreadPool& getInstance();
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  unsigned getSize() const;
+  void parallelFor(size_t count, const std::function<void(size_t, size_t)>& body);
+  // without workers the task waits in the queue until somebody blocks, so the submitter must be able to run it itself
+  void submit(std::function<void()> task);
+  // runs a wait that depends on other tasks; if no thread is left to run the queued ones, a spare worker is started,
+  // and it retires once the queue is empty and fewer threads are blocked than there are spares
+  void block(const std::function<void()>& wait);
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  explicit ThreadPool(unsigned workers);
+  void addWorker();
+  void workerLoop(unsigned index);
+  bool runPendingTask(unsigned index);
+  bool isSurplus(unsigned index) const;
+
+  std::vector<std::unique_ptr<Queue>> queues;
+  std::vector<std::thread> threads;
+  // slots in threads whose spare worker has returned and can be joined and reused
+  std::vector<unsigned> retired;
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::atomic<size_t> pending;
+  std::atomic<size_t> nextQueue;
+  unsigned size;
+  unsigned idle;
+  unsigned blocked;
+  unsigned spare;
+  bool stopping;
+};
+
+#endif //PROG_LANG_THREAD_POOL_H
@@ -1,9 +1,15 @@
 #include "types.h"
 
+#include <limits>
+
 namespace {
 const int BASE = 8;
 }
 
+bool isTypeNestable(int type) {
+  return type <= (std::numeric_limits<int>::max() - BASE - 1) / BASE;
+}
+
 int TYPE_ARRAY(int type) {
   return BASE * type + 5;
 }
@@ -39,3 +45,28 @@ bool isTypeList(int type) {
 int getListElementType(int listType) {
   return listType / BASE;
 }
+
+int TYPE_TASK(int type) {
+  // shifted so that tasks without a result do not collide with the primitive types
+  return BASE * (type + 1) + 1;
+}
+
+bool isTypeTask(int type) {
+  return type > BASE && type % BASE == 1;
+}
+
+int getTaskResultType(int taskType) {
+  return taskType / BASE - 1;
+}
+
+int TYPE_CHANNEL(int type) {
+  return BASE * type + 2;
+}
+
+bool isTypeChannel(int type) {
+  return type > BASE && type % BASE == 2;
+}
+
+int getChannelElementType(int channelType) {
+  return channelType / BASE;
+}
@@ -6,6 +6,12 @@ const int TYPE_BOOLEAN = 1;
 const int TYPE_NUMBER = 2;
 const int TYPE_STRING = 3;
 const int TYPE_MIXED = 4;
+// the lines of a file, read lazily; placed where it can not collide with the composite types below
+const int TYPE_LINES = 11;
+const int TYPE_WRITER = 19;
+
+// composite types multiply their element type, so only a bounded nesting depth fits in an int
+bool isTypeNestable(int type);
 
 int TYPE_ARRAY(int type);
 bool isTypeArray(int type);
@@ -19,4 +25,12 @@ int TYPE_LIST(int type);
 bool isTypeList(int type);
 int getListElementType(int listType);
 
+int TYPE_TASK(int type);
+bool isTypeTask(int type);
+int getTaskResultType(int taskType);
+
+int TYPE_CHANNEL(int type);
+bool isTypeChannel(int type);
+int getChannelElementType(int channelType);
+
 #endif //PROG_LANG_TYPES_H
@@ -1,5 +1,6 @@
 #include "value.h"
 
+#include "mapped_file.h"
 #include "store.h"
 
 int Lvalue::getType() const { return getRvalue()->getType(); }
@@ -19,3 +20,36 @@ const Rvalue* ElementLvalue::getRvalue() const {
 void ElementLvalue::setValue(std::unique_ptr<Rvalue> value) const {
   store.setValue(name, index, std::move(value));
 }
+
+ArrayRvalue::ArrayRvalue(std::shared_ptr<MappedFile> file)
+    : type(TYPE_ARRAY(TYPE_NUMBER)), value(std::make_shared<std::vector<std::shared_ptr<Rvalue>>>()),
+      numbers(std::make_shared<NumberStore>()) {
+  numbers->file = std::move(file);
+}
+
+const double* ArrayRvalue::getNumbers() const {
+  if (!numbers || numbers->materialized.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return reinterpret_cast<const double*>(numbers->file->getData());
+}
+
+size_t ArrayRvalue::getSize() const {
+  if (getNumbers() != nullptr) {
+    return numbers->file->getSize() / sizeof(double);
+  }
+  return getValue()->size();
+}
+
+// every copy of the array shares the store, so the elements are created once and modifications stay visible to all
+void ArrayRvalue::materialize() const {
+  std::call_once(numbers->once, [this]() {
+    auto data = reinterpret_cast<const double*>(numbers->file->getData());
+    size_t size = numbers->file->getSize() / sizeof(double);
+    value->reserve(size);
+    for (size_t i = 0; i < size; ++i) {
+      value->push_back(std::make_shared<NumberRvalue>(data[i]));
+    }
+    numbers->materialized.store(true, std::memory_order_release);
+  });
+}
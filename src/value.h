@@ -1,13 +1,21 @@
 #ifndef PROG_LANG_VALUE_H
 #define PROG_LANG_VALUE_H
 
-#include <string>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
-#include "node.h"
 #include "types.h"
 
 class Rvalue;
+class Store;
+class Task;
+class Channel;
+class MappedFile;
+class FileWriter;
 
 class Value {
  public:
@@ -29,18 +37,22 @@ class Rvalue : public Value {
 
 class Lvalue : public Value {
  public:
-  explicit Lvalue(std::string name) : name(std::move(name)) {}
+  Lvalue(Store& store, std::string name) : name(std::move(name)), store(store) {}
   MemoryClass getMemoryClass() const override { return LVALUE; }
   int getType() const override;
   const Rvalue* getRvalue() const override;
   virtual void setValue(std::unique_ptr<Rvalue> value) const;
 
   std::string name;
+
+ protected:
+  Store& store;
 };
 
 class ElementLvalue : public Lvalue {
  public:
-  ElementLvalue(std::string name, std::vector<int> index) : Lvalue(std::move(name)), index(std::move(index)) {}
+  ElementLvalue(Store& store, std::string name, std::vector<int> index)
+      : Lvalue(store, std::move(name)), index(std::move(index)) {}
   const Rvalue* getRvalue() const override;
   void setValue(std::unique_ptr<Rvalue> value) const override;
 
@@ -72,7 +84,7 @@ class StringRvalue : public Rvalue {
  public:
   explicit StringRvalue(std::string value) : value(std::move(value)) {}
   int getType() const override { return TYPE_STRING; }
-  std::string getValue() const { return value; }
+  const std::string& getValue() const { return value; }
 
  private:
   std::string value;
@@ -83,14 +95,45 @@ class ArrayRvalue : public Rvalue {
   explicit ArrayRvalue(int type) : value(std::make_shared<std::vector<std::shared_ptr<Rvalue>>>()), type(type) {}
   ArrayRvalue(int type, std::vector<std::shared_ptr<Rvalue>> v)
     : value(std::make_shared<std::vector<std::shared_ptr<Rvalue>>>(std::move(v))), type(type) {}
-  ArrayRvalue(const ArrayRvalue& other) : type(other.type), value(other.value) {}
+  // an array of numbers backed by a file of raw doubles; its elements are only created once something needs them
+  explicit ArrayRvalue(std::shared_ptr<MappedFile> file);
+  ArrayRvalue(const ArrayRvalue& other) : type(other.type), value(other.value), numbers(other.numbers) {}
   int getType() const override { return type; }
   int getElementType() const { return getArrayElementType(type); }
-  const std::shared_ptr<std::vector<std::shared_ptr<Rvalue>>>& getValue() const { return value; }
+  const std::shared_ptr<std::vector<std::shared_ptr<Rvalue>>>& getValue() const {
+    if (numbers) {
+      materialize();
+    }
+    return value;
+  }
+  // the file contents while the elements have not been created yet, null afterwards
+  const double* getNumbers() const;
+  const std::shared_ptr<MappedFile>& getFile() const { return numbers->file; }
+  size_t getSize() const;
 
  private:
+  struct NumberStore {
+    std::shared_ptr<MappedFile> file;
+    std::once_flag once;
+    std::atomic<bool> materialized{false};
+  };
+
+  void materialize() const;
+
   int type;
   std::shared_ptr<std::vector<std::shared_ptr<Rvalue>>> value;
+  std::shared_ptr<NumberStore> numbers;
+};
+
+// element of a file backed array; reading it leaves the array alone, assigning to it materializes the array
+class NumberElementLvalue : public ElementLvalue {
+ public:
+  NumberElementLvalue(Store& store, std::string name, std::vector<int> index, double value)
+      : ElementLvalue(store, std::move(name), std::move(index)), value(value) {}
+  const Rvalue* getRvalue() const override { return &value; }
+
+ private:
+  NumberRvalue value;
 };
 
 class ListRvalue : public Rvalue {
@@ -105,4 +148,47 @@ class ListRvalue : public Rvalue {
   std::vector<std::shared_ptr<Rvalue>> value;
 };
 
+class TaskRvalue : public Rvalue {
+ public:
+  TaskRvalue(int type, std::shared_ptr<Task> task) : type(type), task(std::move(task)) {}
+  int getType() const override { return type; }
+  const std::shared_ptr<Task>& getTask() const { return task; }
+
+ private:
+  int type;
+  std::shared_ptr<Task> task;
+};
+
+class ChannelRvalue : public Rvalue {
+ public:
+  ChannelRvalue(int type, std::shared_ptr<Channel> channel) : type(type), channel(std::move(channel)) {}
+  int getType() const override { return type; }
+  int getElementType() const { return getChannelElementType(type); }
+  const std::shared_ptr<Channel>& getChannel() const { return channel; }
+
+ private:
+  int type;
+  std::shared_ptr<Channel> channel;
+};
+
+class LinesRvalue : public Rvalue {
+ public:
+  explicit LinesRvalue(std::shared_ptr<MappedFile> file) : file(std::move(file)) {}
+  int getType() const override { return TYPE_LINES; }
+  const std::shared_ptr<MappedFile>& getFile() const { return file; }
+
+ private:
+  std::shared_ptr<MappedFile> file;
+};
+
+class WriterRvalue : public Rvalue {
+ public:
+  explicit WriterRvalue(std::shared_ptr<FileWriter> writer) : writer(std::move(writer)) {}
+  int getType() const override { return TYPE_WRITER; }
+  const std::shared_ptr<FileWriter>& getWriter() const { return writer; }
+
+ private:
+  std::shared_ptr<FileWriter> writer;
+};
+
 #endif //PROG_LANG_PRIMITIVE_VALUE_H
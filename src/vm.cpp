@@ -1,10 +1,26 @@
 #include "vm.h"
 
+#include <atomic>
 #include <cmath>
-#include <iostream>
+#include <cstring>
 
+#include "array_sort.h"
+#include "channel.h"
+#include "context.h"
+#include "file_loader.h"
+#include "file_writer.h"
+#include "mapped_file.h"
+#include "number_file.h"
+#include "number_format.h"
+#include "numeric_kernels.h"
 #include "runtime_error.h"
-#include "store.h"
+#include "semantic_analyzer.h"
+#include "string_kernels.h"
+#include "task.h"
+#include "thread_pool.h"
+
+VirtualMachine::VirtualMachine(Context& context)
+    : context(context), store(context.getStore()), input(context.getInput()), output(context.getOutput()) {}
 
 std::pair<bool, std::unique_ptr<Value>> VirtualMachine::run(Node* node) {
   if (node->getType() == Node::BLOCK) {
@@ -26,40 +42,38 @@ std::pair<bool, std::unique_ptr<Value>> VirtualMachine::run(Node* node) {
       return std::make_pair(true, nullptr);
     }
     auto retExprU = evalExp(retNode->getExpression().get());
-    auto retExpr = retExprU->getRvalue();
-    int type = retExpr->getType();
-    std::unique_ptr<Value> nv;
-    if (type == TYPE_BOOLEAN) {
-      nv = std::make_unique<BooleanRvalue>(dynamic_cast<const BooleanRvalue*>(retExpr)->getValue());
-    } else if (type == TYPE_NUMBER) {
-      nv = std::make_unique<NumberRvalue>(dynamic_cast<const NumberRvalue*>(retExpr)->getValue());
-    } else if (type == TYPE_STRING) {
-      nv = std::make_unique<StringRvalue>(dynamic_cast<const StringRvalue*>(retExpr)->getValue());
-    } else {
-      nv = std::make_unique<ArrayRvalue>(*dynamic_cast<const ArrayRvalue*>(retExpr));
-    }
-    return std::make_pair(true, std::move(nv));
+    return std::make_pair(true, copyRvalue(retExprU->getRvalue()));
   } else if (node->getType() == Node::PRINT_INSTRUCTION) {
     auto value = evalExp(dynamic_cast<PrintInstructionNode*>(node)->getExpression().get());
     switch (value->getType()) {
       case TYPE_BOOLEAN:
-        std::cout << (getBooleanValue(value) ? "true\n" : "false\n");
+        output << (getBooleanValue(value) ? "true\n" : "false\n");
         break;
-      case TYPE_NUMBER:
-        std::cout << getNumberValue(value) << "\n";
+      case TYPE_NUMBER: {
+        char buffer[NumberFormat::MAX_LENGTH + 1];
+        char* end = NumberFormat::format(buffer, getNumberValue(value));
+        *end++ = '\n';
+        output.write(buffer, end - buffer);
         break;
+      }
       case TYPE_STRING:
-        std::cout << getStringValue(value) << "\n";
+        output << dynamic_cast<const StringRvalue*>(value->getRvalue())->getValue() << '\n';
         break;
     }
   } else if (node->getType() == Node::READ_INSTRUCTION) {
-    auto value = evalExp(dynamic_cast<ReadInstructionNode*>(node)->getExpression().get());
+    auto readNode = dynamic_cast<ReadInstructionNode*>(node);
+    auto value = evalExp(readNode->getExpression().get());
+    if (readNode->getCount()) {
+      readArray(value, getNumberValue(evalExp(readNode->getCount().get())));
+      return std::make_pair(false, std::unique_ptr<Value>(nullptr));
+    }
+    auto& scanner = context.getScanner();
     bool booleanValue;
     double numberValue;
     std::string stringValue;
     switch (value->getType()) {
       case TYPE_BOOLEAN:
-        std::cin >> stringValue;
+        stringValue = scanner.nextToken();
         if (stringValue == "true" || stringValue == "TRUE" || stringValue == "1" || stringValue == "t" ||
             stringValue == "T") {
           booleanValue = true;
@@ -72,13 +86,13 @@ std::pair<bool, std::unique_ptr<Value>> VirtualMachine::run(Node* node) {
         dynamic_cast<Lvalue*>(value.get())->setValue(std::make_unique<BooleanRvalue>(booleanValue));
         break;
       case TYPE_NUMBER:
-        if (!(std::cin >> numberValue)) {
+        if (!scanner.nextNumber(numberValue)) {
           throw RuntimeError("invalid input for number type");
         }
         dynamic_cast<Lvalue*>(value.get())->setValue(std::make_unique<NumberRvalue>(numberValue));
         break;
       case TYPE_STRING:
-        std::cin >> stringValue;
+        stringValue = scanner.nextToken();
         dynamic_cast<Lvalue*>(value.get())->setValue(std::make_unique<StringRvalue>(stringValue));
         break;
     }
@@ -104,11 +118,7 @@ std::pair<bool, std::unique_ptr<Value>> VirtualMachine::run(Node* node) {
     store.registerName(varDecNode->getVariableName(), std::make_unique<VariableData>(type, std::move(exprRet)));
   } else if (node->getType() == Node::FUNCTION_DEFINITION) {
     auto fncDefNode = dynamic_cast<FunctionDefinitionNode*>(node);
-    store.registerName(fncDefNode->getFunctionName(), std::make_unique<FunctionData>(
-        fncDefNode->getArguments(),
-        fncDefNode->getReturnType(),
-        fncDefNode->getBlock()
-    ));
+    store.registerName(fncDefNode->getFunctionName(), std::make_unique<FunctionData>(fncDefNode));
   } else if (node->getType() == Node::IF_STATEMENT) {
     auto ifNode = dynamic_cast<IfNode*>(node);
     if (getBooleanValue(evalExp(ifNode->getCondition().get()))) {
@@ -133,7 +143,41 @@ std::pair<bool, std::unique_ptr<Value>> VirtualMachine::run(Node* node) {
   } else if (node->getType() == Node::FOR_STATEMENT) {
     auto forNode = dynamic_cast<ForNode*>(node);
     auto range = evalExp(forNode->getRangeExpression().get());
-    if (range->getType() == TYPE_STRING) {
+    if (forNode->isParallel()) {
+      runParallel(forNode, range.get());
+    } else if (range->getType() == TYPE_LINES) {
+      const auto& file = dynamic_cast<const LinesRvalue*>(range->getRvalue())->getFile();
+      const char* position = file->getData();
+      const char* end = position + file->getSize();
+      while (position < end) {
+        auto lineEnd = static_cast<const char*>(std::memchr(position, '\n', end - position));
+        if (lineEnd == nullptr) {
+          lineEnd = end;
+        }
+        store.newLevel();
+        auto line = std::make_unique<StringRvalue>(std::string(position, lineEnd));
+        store.registerName(forNode->getIterName(), std::make_unique<VariableData>(TYPE_STRING, std::move(line)));
+        auto ret = run(forNode->getBlock().get());
+        store.deleteLevel();
+        if (ret.first) {
+          return std::move(ret);
+        }
+        position = lineEnd + 1;
+      }
+    } else if (isTypeChannel(range->getType())) {
+      const auto& channel = getChannel(range);
+      std::shared_ptr<Rvalue> value;
+      while (channel->receive(value)) {
+        store.newLevel();
+        store.registerName(forNode->getIterName(),
+            std::make_unique<VariableData>(getChannelElementType(range->getType()), copyRvalue(value.get())));
+        auto ret = run(forNode->getBlock().get());
+        store.deleteLevel();
+        if (ret.first) {
+          return std::move(ret);
+        }
+      }
+    } else if (range->getType() == TYPE_STRING) {
       auto s = dynamic_cast<const StringRvalue*>(range->getRvalue())->getValue();
       for (char c : s) {
         std::string cs;
@@ -147,34 +191,173 @@ std::pair<bool, std::unique_ptr<Value>> VirtualMachine::run(Node* node) {
           return std::move(ret);
         }
       }
+    } else if (isTypeArray(range->getType()) &&
+               dynamic_cast<const ArrayRvalue*>(range->getRvalue())->getNumbers() != nullptr) {
+      // a file backed array is iterated without creating its elements, unless the loop body modifies it
+      ArrayRvalue array(*dynamic_cast<const ArrayRvalue*>(range->getRvalue()));
+      size_t size = array.getSize();
+      for (size_t i = 0; i < size; ++i) {
+        const double* numbers = array.getNumbers();
+        double number = numbers != nullptr
+                        ? numbers[i]
+                        : dynamic_cast<const NumberRvalue*>((*array.getValue())[i].get())->getValue();
+        store.newLevel();
+        store.registerName(forNode->getIterName(),
+            std::make_unique<VariableData>(TYPE_NUMBER, std::make_unique<NumberRvalue>(number)));
+        run(forNode->getBlock().get());
+        store.deleteLevel();
+      }
     } else {
       const auto& arr = isTypeArray(range->getType())
                         ? *dynamic_cast<const ArrayRvalue*>(range->getRvalue())->getValue()
                         : dynamic_cast<const ListRvalue*>(range->getRvalue())->getValue();
       for (const auto& it : arr) {
-        auto rv = it->getRvalue();
-        int type = rv->getType();
-        std::unique_ptr<Value> elem;
-        if (type == TYPE_BOOLEAN) {
-          elem = std::make_unique<BooleanRvalue>(dynamic_cast<const BooleanRvalue*>(rv)->getValue());
-        } else if (type == TYPE_NUMBER) {
-          elem = std::make_unique<NumberRvalue>(dynamic_cast<const NumberRvalue*>(rv)->getValue());
-        } else if (type == TYPE_STRING) {
-          elem = std::make_unique<StringRvalue>(dynamic_cast<const StringRvalue*>(rv)->getValue());
-        } else {
-          elem = std::make_unique<ArrayRvalue>(*dynamic_cast<const ArrayRvalue*>(rv));
-        }
         store.newLevel();
         store.registerName(forNode->getIterName(),
-            std::make_unique<VariableData>(getArrayElementType(range->getType()), std::move(elem)));
+            std::make_unique<VariableData>(getArrayElementType(range->getType()), copyRvalue(it->getRvalue())));
         run(forNode->getBlock().get());
         store.deleteLevel();
       }
     }
+  } else if (node->getType() == Node::IMPORT_STATEMENT) {
+    store.importLevel(context.getModuleLoader().execute(dynamic_cast<ImportNode*>(node)->getModule()));
   }
   return std::make_pair(false, std::unique_ptr<Value>(nullptr));
 }
 
+std::unique_ptr<Value> VirtualMachine::call(FunctionData* function, std::vector<std::unique_ptr<Value>> arguments) {
+  SemanticAnalyzer(context).prepareFunction(function);
+  store.newLevel();
+  for (size_t i = 0; i < arguments.size(); ++i) {
+    store.registerName(function->getArguments()[i].first,
+        std::make_unique<VariableData>(function->getArguments()[i].second, std::move(arguments[i])));
+  }
+  auto ret = run(function->getBlock().get());
+  store.deleteLevel();
+  if (function->getReturnType() != TYPE_NONE && !ret.first) {
+    throw RuntimeError("non-void function finished execution without returning any value");
+  }
+  return std::move(ret.second);
+}
+
+void VirtualMachine::readArray(const std::unique_ptr<Value>& array, double count) {
+  if (count < 0 || count != std::floor(count)) {
+    throw RuntimeError("read count should be a non-negative integer");
+  }
+  auto& scanner = context.getScanner();
+  bool numbers = getArrayElementType(array->getType()) == TYPE_NUMBER;
+  std::vector<std::shared_ptr<Rvalue>> elements;
+  elements.reserve(static_cast<size_t>(std::min(count, 1e6)));
+  for (double i = 0; i < count; ++i) {
+    if (numbers) {
+      double number;
+      if (!scanner.nextNumber(number)) {
+        throw RuntimeError("invalid input for number type");
+      }
+      elements.push_back(std::make_shared<NumberRvalue>(number));
+    } else {
+      auto token = scanner.nextToken();
+      if (token.empty()) {
+        throw RuntimeError("not enough input for read");
+      }
+      elements.push_back(std::make_shared<StringRvalue>(std::move(token)));
+    }
+  }
+  dynamic_cast<Lvalue*>(array.get())->setValue(std::make_unique<ArrayRvalue>(array->getType(), std::move(elements)));
+}
+
+void VirtualMachine::runParallel(ForNode* node, const Value* range) {
+  std::vector<std::shared_ptr<Rvalue>> elements;
+  int elemType;
+  if (range->getType() == TYPE_STRING) {
+    for (char c : dynamic_cast<const StringRvalue*>(range->getRvalue())->getValue()) {
+      elements.push_back(std::make_shared<StringRvalue>(std::string(1, c)));
+    }
+    elemType = TYPE_STRING;
+  } else if (isTypeArray(range->getType())) {
+    elements = *dynamic_cast<const ArrayRvalue*>(range->getRvalue())->getValue();
+    elemType = getArrayElementType(range->getType());
+  } else {
+    elements = dynamic_cast<const ListRvalue*>(range->getRvalue())->getValue();
+    elemType = getListElementType(range->getType());
+  }
+  std::vector<std::shared_ptr<Rvalue>> results(elements.size());
+  std::atomic<bool> failed(false);
+  ThreadPool::getInstance().parallelFor(elements.size(), [&](size_t begin, size_t end) {
+    Context worker(context);
+    VirtualMachine vm(worker);
+    try {
+      for (size_t i = begin; i < end && !failed; ++i) {
+        vm.store.newLevel();
+        vm.store.registerName(node->getIterName(),
+            std::make_unique<VariableData>(elemType, copyRvalue(elements[i].get())));
+        vm.run(node->getBlock().get());
+        results[i] = copyRvalue(vm.store.getValue(node->getIterName()).get());
+        vm.store.deleteLevel();
+      }
+      worker.joinTasks();
+    } catch (...) {
+      failed = true;
+      throw;
+    }
+  });
+  // every iteration owns its element, so assignments to the iteration variable are stored back into the array
+  if (isTypeArray(range->getType())) {
+    auto& array = *dynamic_cast<const ArrayRvalue*>(range->getRvalue())->getValue();
+    if (array.size() == results.size()) {
+      std::move(results.begin(), results.end(), array.begin());
+    }
+  }
+}
+
+std::unique_ptr<Value> VirtualMachine::spawn(SpawnNode* node) {
+  auto call = node->getCall().get();
+  auto definition = store.getFunctionData(call->getFunctionName())->getDefinition();
+  std::vector<std::shared_ptr<Rvalue>> arguments;
+  for (const auto& argument : call->getArguments()) {
+    // the task runs next to its spawner, so it gets its own copy of every array
+    arguments.push_back(cloneRvalue(evalExp(argument.get())->getRvalue()));
+  }
+  auto functions = node->getFunctions();
+  bool lazy = context.isLazyFunctionAnalysis();
+  std::istream& taskInput = input;
+  auto task = std::make_shared<Task>([=, &taskInput](std::ostream& taskOutput) -> std::unique_ptr<Rvalue> {
+    Context taskContext(taskInput, taskOutput);
+    taskContext.setLazyFunctionAnalysis(lazy);
+    auto& taskStore = taskContext.getStore();
+    taskStore.newLevel();
+    for (auto function : functions) {
+      if (taskStore.getLevelOf(function->getFunctionName()) == -1) {
+        taskStore.registerName(function->getFunctionName(), std::make_unique<FunctionData>(function));
+      }
+    }
+    taskStore.newLevel();
+    for (size_t i = 0; i < arguments.size(); ++i) {
+      taskStore.registerName(definition->getArguments()[i].first,
+          std::make_unique<VariableData>(definition->getArguments()[i].second, copyRvalue(arguments[i].get())));
+    }
+    auto ret = VirtualMachine(taskContext).run(definition->getBlock().get());
+    if (definition->getReturnType() != TYPE_NONE && !ret.first) {
+      throw RuntimeError("non-void function finished execution without returning any value");
+    }
+    taskContext.joinTasks();
+    return ret.second ? copyRvalue(ret.second->getRvalue()) : nullptr;
+  });
+  context.addTask(task);
+  ThreadPool::getInstance().submit([task]() { task->run(); });
+  return std::make_unique<TaskRvalue>(node->getResultType(), task);
+}
+
+std::unique_ptr<Value> VirtualMachine::await(AwaitNode* node) {
+  auto value = evalExp(node->getTask().get());
+  const auto& task = dynamic_cast<const TaskRvalue*>(value->getRvalue())->getTask();
+  if (!task) {
+    throw RuntimeError("await on a task that was never spawned");
+  }
+  task->await(output);
+  return task->getResult() ? copyRvalue(task->getResult().get()) : nullptr;
+}
+
 std::unique_ptr<Value> VirtualMachine::evalExp(ExpressionNode* node) {
   if (node->getType() == Node::BOOLEAN_VALUE) {
     return std::make_unique<BooleanRvalue>(dynamic_cast<BooleanValueNode*>(node)->getValue());
@@ -205,12 +388,35 @@ std::unique_ptr<Value> VirtualMachine::evalExp(ExpressionNode* node) {
         v.emplace_back(std::make_shared<StringRvalue>(dynamic_cast<const StringRvalue*>(expRes)->getValue()));
       } else if (isTypeArray(type)) {
         v.emplace_back(std::make_shared<ArrayRvalue>(*dynamic_cast<const ArrayRvalue*>(expRes)));
+      } else if (isTypeTask(type)) {
+        v.emplace_back(std::make_shared<TaskRvalue>(*dynamic_cast<const TaskRvalue*>(expRes)));
+      } else if (isTypeChannel(type)) {
+        v.emplace_back(std::make_shared<ChannelRvalue>(*dynamic_cast<const ChannelRvalue*>(expRes)));
+      } else if (type == TYPE_LINES) {
+        v.emplace_back(std::make_shared<LinesRvalue>(*dynamic_cast<const LinesRvalue*>(expRes)));
+      } else if (type == TYPE_WRITER) {
+        v.emplace_back(std::make_shared<WriterRvalue>(*dynamic_cast<const WriterRvalue*>(expRes)));
       }
     }
     return std::make_unique<ListRvalue>(TYPE_LIST(lt), std::move(v));
   }
   if (node->getType() == Node::VARIABLE) {
-    return std::make_unique<Lvalue>(dynamic_cast<VariableNode*>(node)->getName());
+    return std::make_unique<Lvalue>(store, dynamic_cast<VariableNode*>(node)->getName());
+  }
+  if (node->getType() == Node::SPAWN) {
+    return spawn(dynamic_cast<SpawnNode*>(node));
+  }
+  if (node->getType() == Node::AWAIT) {
+    return await(dynamic_cast<AwaitNode*>(node));
+  }
+  if (node->getType() == Node::CHANNEL) {
+    auto channelNode = dynamic_cast<ChannelNode*>(node);
+    double capacity = getNumberValue(evalExp(channelNode->getCapacity().get()));
+    if (capacity < 1 || capacity != std::floor(capacity)) {
+      throw RuntimeError("channel capacity should be a positive integer");
+    }
+    return std::make_unique<ChannelRvalue>(channelNode->getChannelType(),
+                                           std::make_shared<Channel>(static_cast<size_t>(capacity)));
   }
   if (node->getType() == Node::FUNCTION_CALL) {
     auto fncNode = dynamic_cast<FunctionCallNode*>(node);
@@ -218,7 +424,7 @@ std::unique_ptr<Value> VirtualMachine::evalExp(ExpressionNode* node) {
     const auto& arguments = fncNode->getArguments();
     if (name == "toNumber") {
       return std::make_unique<NumberRvalue>(
-          std::stod(dynamic_cast<const StringRvalue*>(evalExp(arguments[0].get())->getRvalue())->getValue())
+          NumberFormat::parse(dynamic_cast<const StringRvalue*>(evalExp(arguments[0].get())->getRvalue())->getValue())
       );
     }
     if (name == "toString") {
@@ -229,7 +435,7 @@ std::unique_ptr<Value> VirtualMachine::evalExp(ExpressionNode* node) {
         );
       }
       return std::make_unique<StringRvalue>(
-          std::to_string(dynamic_cast<const NumberRvalue*>(exp->getRvalue())->getValue())
+          NumberFormat::toString(dynamic_cast<const NumberRvalue*>(exp->getRvalue())->getValue())
       );
     }
     if (name == "len") {
@@ -239,7 +445,7 @@ std::unique_ptr<Value> VirtualMachine::evalExp(ExpressionNode* node) {
     }
     if (name == "size") {
       return std::make_unique<NumberRvalue>(
-          dynamic_cast<const ArrayRvalue*>(evalExp(arguments[0].get())->getRvalue())->getValue()->size()
+          dynamic_cast<const ArrayRvalue*>(evalExp(arguments[0].get())->getRvalue())->getSize()
       );
     }
     if (name == "add") {
@@ -256,18 +462,229 @@ std::unique_ptr<Value> VirtualMachine::evalExp(ExpressionNode* node) {
         v.emplace_back(std::make_shared<StringRvalue>(dynamic_cast<const StringRvalue*>(expRes)->getValue()));
       } else if (isTypeArray(type)) {
         v.emplace_back(std::make_shared<ArrayRvalue>(*dynamic_cast<const ArrayRvalue*>(expRes)));
+      } else if (isTypeTask(type)) {
+        v.emplace_back(std::make_shared<TaskRvalue>(*dynamic_cast<const TaskRvalue*>(expRes)));
+      } else if (isTypeChannel(type)) {
+        v.emplace_back(std::make_shared<ChannelRvalue>(*dynamic_cast<const ChannelRvalue*>(expRes)));
+      } else if (type == TYPE_LINES) {
+        v.emplace_back(std::make_shared<LinesRvalue>(*dynamic_cast<const LinesRvalue*>(expRes)));
+      } else if (type == TYPE_WRITER) {
+        v.emplace_back(std::make_shared<WriterRvalue>(*dynamic_cast<const WriterRvalue*>(expRes)));
+      }
+      return nullptr;
+    }
+    if (name == "readLines") {
+      return std::make_unique<LinesRvalue>(std::make_shared<MappedFile>(getStringValue(evalExp(arguments[0].get()))));
+    }
+    if (name == "readFile") {
+      return std::make_unique<StringRvalue>(FileLoader::read(getStringValue(evalExp(arguments[0].get()))));
+    }
+    if (name == "readFiles") {
+      auto expr = evalExp(arguments[0].get());
+      std::vector<std::string> paths;
+      for (const auto& path : *dynamic_cast<const ArrayRvalue*>(expr->getRvalue())->getValue()) {
+        paths.push_back(dynamic_cast<const StringRvalue*>(path.get())->getValue());
+      }
+      std::vector<std::shared_ptr<Rvalue>> contents;
+      contents.reserve(paths.size());
+      for (auto& content : FileLoader::readAll(paths)) {
+        contents.push_back(std::make_shared<StringRvalue>(std::move(content)));
+      }
+      return std::make_unique<ArrayRvalue>(TYPE_ARRAY(TYPE_STRING), std::move(contents));
+    }
+    if (name == "loadNumbers") {
+      return std::make_unique<ArrayRvalue>(NumberFile::load(getStringValue(evalExp(arguments[0].get()))));
+    }
+    if (name == "saveNumbers") {
+      auto expr0 = evalExp(arguments[0].get());
+      auto expr1 = evalExp(arguments[1].get());
+      auto array = dynamic_cast<const ArrayRvalue*>(expr1->getRvalue());
+      if (array->getNumbers() != nullptr) {
+        NumberFile::save(getStringValue(expr0), array->getNumbers(), array->getSize());
+      } else {
+        auto numbers = getNumberArray(expr1);
+        NumberFile::save(getStringValue(expr0), numbers.data(), numbers.size());
       }
       return nullptr;
     }
+    if (name == "find" || name == "contains") {
+      auto expr0 = evalExp(arguments[0].get());
+      auto expr1 = evalExp(arguments[1].get());
+      const auto& text = getStringValue(expr0);
+      const auto& pattern = getStringValue(expr1);
+      size_t position = StringKernels::find(text.data(), text.size(), pattern.data(), pattern.size());
+      if (name == "contains") {
+        return std::make_unique<BooleanRvalue>(position != text.size() || pattern.empty());
+      }
+      return std::make_unique<NumberRvalue>(position == text.size() && !pattern.empty() ? -1.0 : position);
+    }
+    if (name == "startsWith") {
+      auto expr0 = evalExp(arguments[0].get());
+      auto expr1 = evalExp(arguments[1].get());
+      const auto& text = getStringValue(expr0);
+      const auto& prefix = getStringValue(expr1);
+      return std::make_unique<BooleanRvalue>(prefix.size() <= text.size() &&
+                                             std::memcmp(text.data(), prefix.data(), prefix.size()) == 0);
+    }
+    if (name == "split") {
+      auto expr0 = evalExp(arguments[0].get());
+      auto expr1 = evalExp(arguments[1].get());
+      const auto& text = getStringValue(expr0);
+      const auto& separator = getStringValue(expr1);
+      if (separator.empty()) {
+        throw RuntimeError("split with an empty separator");
+      }
+      std::vector<std::shared_ptr<Rvalue>> parts;
+      const char* first = text.data();
+      const char* last = first + text.size();
+      while (true) {
+        size_t length = StringKernels::find(first, last - first, separator.data(), separator.size());
+        parts.push_back(std::make_shared<StringRvalue>(std::string(first, length)));
+        if (first + length == last) {
+          break;
+        }
+        first += length + separator.size();
+      }
+      return std::make_unique<ArrayRvalue>(TYPE_ARRAY(TYPE_STRING), std::move(parts));
+    }
+    if (name == "replace") {
+      auto expr0 = evalExp(arguments[0].get());
+      auto expr1 = evalExp(arguments[1].get());
+      auto expr2 = evalExp(arguments[2].get());
+      const auto& text = getStringValue(expr0);
+      const auto& from = getStringValue(expr1);
+      const auto& to = getStringValue(expr2);
+      if (from.empty()) {
+        throw RuntimeError("replace of an empty string");
+      }
+      std::string result;
+      result.reserve(text.size());
+      const char* first = text.data();
+      const char* last = first + text.size();
+      while (true) {
+        size_t length = StringKernels::find(first, last - first, from.data(), from.size());
+        result.append(first, length);
+        if (first + length == last) {
+          break;
+        }
+        result += to;
+        first += length + from.size();
+      }
+      return std::make_unique<StringRvalue>(std::move(result));
+    }
+    if (name == "trim") {
+      auto expr = evalExp(arguments[0].get());
+      const auto& text = getStringValue(expr);
+      const char* first = text.data();
+      const char* last = first + text.size();
+      StringKernels::trim(first, last);
+      return std::make_unique<StringRvalue>(std::string(first, last));
+    }
+    if (name == "send") {
+      auto expr0 = evalExp(arguments[0].get());
+      auto expr1 = evalExp(arguments[1].get());
+      if (!getChannel(expr0)->send(copyRvalue(expr1->getRvalue()))) {
+        throw RuntimeError("send on a closed channel");
+      }
+      return nullptr;
+    }
+    if (name == "receive") {
+      std::shared_ptr<Rvalue> value;
+      if (!getChannel(evalExp(arguments[0].get()))->receive(value)) {
+        throw RuntimeError("receive from a closed channel");
+      }
+      return copyRvalue(value.get());
+    }
+    if (name == "close") {
+      auto expr = evalExp(arguments[0].get());
+      if (expr->getType() == TYPE_WRITER) {
+        getWriter(expr)->close();
+        return nullptr;
+      }
+      getChannel(expr)->close();
+      return nullptr;
+    }
+    if (name == "openWrite") {
+      return std::make_unique<WriterRvalue>(std::make_shared<FileWriter>(getStringValue(evalExp(arguments[0].get()))));
+    }
+    if (name == "write" || name == "writeLine") {
+      auto expr0 = evalExp(arguments[0].get());
+      auto expr1 = evalExp(arguments[1].get());
+      const auto& writer = getWriter(expr0);
+      char buffer[NumberFormat::MAX_LENGTH];
+      const char* data = buffer;
+      size_t size;
+      if (expr1->getType() == TYPE_BOOLEAN) {
+        data = getBooleanValue(expr1) ? "true" : "false";
+        size = std::strlen(data);
+      } else if (expr1->getType() == TYPE_NUMBER) {
+        size = NumberFormat::format(buffer, getNumberValue(expr1)) - buffer;
+      } else {
+        data = getStringValue(expr1).data();
+        size = getStringValue(expr1).size();
+      }
+      if (name == "writeLine") {
+        writer->writeLine(data, size);
+      } else {
+        writer->write(data, size);
+      }
+      return nullptr;
+    }
+    if (name == "sort" || name == "sorted") {
+      auto expr0 = evalExp(arguments[0].get());
+      auto array = dynamic_cast<const ArrayRvalue*>(expr0->getRvalue());
+      if (name == "sort") {
+        ArraySort::sort(*array->getValue(), array->getElementType());
+        return nullptr;
+      }
+      auto result = std::make_unique<ArrayRvalue>(array->getType(), *array->getValue());
+      ArraySort::sort(*result->getValue(), result->getElementType());
+      return result;
+    }
+    if (name == "binarySearch") {
+      auto expr0 = evalExp(arguments[0].get());
+      auto expr1 = evalExp(arguments[1].get());
+      auto array = dynamic_cast<const ArrayRvalue*>(expr0->getRvalue());
+      return std::make_unique<NumberRvalue>(
+          ArraySort::binarySearch(*array->getValue(), array->getElementType(), expr1->getRvalue())
+      );
+    }
+    if (name == "sum" || name == "min" || name == "max" || name == "mean") {
+      auto numbers = getNumberArray(evalExp(arguments[0].get()));
+      if (numbers.empty() && name != "sum") {
+        throw RuntimeError(name + " of an empty array");
+      }
+      if (name == "min") {
+        return std::make_unique<NumberRvalue>(NumericKernels::min(numbers.data(), numbers.size()));
+      }
+      if (name == "max") {
+        return std::make_unique<NumberRvalue>(NumericKernels::max(numbers.data(), numbers.size()));
+      }
+      double total = NumericKernels::sum(numbers.data(), numbers.size());
+      return std::make_unique<NumberRvalue>(name == "sum" ? total : total / numbers.size());
+    }
+    if (name == "dot") {
+      auto lhs = getNumberArray(evalExp(arguments[0].get()));
+      auto rhs = getNumberArray(evalExp(arguments[1].get()));
+      if (lhs.size() != rhs.size()) {
+        throw RuntimeError("dot product of arrays with different sizes");
+      }
+      return std::make_unique<NumberRvalue>(NumericKernels::dot(lhs.data(), rhs.data(), lhs.size()));
+    }
     auto fncData = store.getFunctionData(name);
+    SemanticAnalyzer(context).prepareFunction(fncData);
     int argc = fncData->getArguments().size();
+    // arguments are evaluated in the caller's scope, before the parameters become visible
+    std::vector<std::unique_ptr<Rvalue>> argv;
+    argv.reserve(argc);
+    for (int i = 0; i < argc; ++i) {
+      argv.push_back(copyRvalue(evalExp(arguments[i].get())->getRvalue()));
+    }
     store.newLevel();
     for (int i = 0; i < argc; ++i) {
-      auto expr = arguments[i].get();
-      auto argv = evalExp(expr);
       store.registerName(
           fncData->getArguments()[i].first,
-          std::make_unique<VariableData>(fncData->getArguments()[i].second, std::move(argv))
+          std::make_unique<VariableData>(fncData->getArguments()[i].second, std::move(argv[i]))
       );
     }
     auto ret = run(fncData->getBlock().get());
@@ -314,23 +731,13 @@ std::unique_ptr<Value> VirtualMachine::evalExp(ExpressionNode* node) {
     case BinaryOperatorNode::AND:
       return std::make_unique<BooleanRvalue>(getBooleanValue(ls) && getBooleanValue(rs));
     case BinaryOperatorNode::ASSIGN:
-      if (ls->getType() == TYPE_BOOLEAN) {
-        dynamic_cast<Lvalue*>(ls.get())->setValue(std::make_unique<BooleanRvalue>(getBooleanValue(rs)));
-      } else if (ls->getType() == TYPE_NUMBER) {
-        dynamic_cast<Lvalue*>(ls.get())->setValue(std::make_unique<NumberRvalue>(getNumberValue(rs)));
-      } else if (ls->getType() == TYPE_STRING) {
-        dynamic_cast<Lvalue*>(ls.get())->setValue(std::make_unique<StringRvalue>(getStringValue(rs)));
-      } else if (isTypeArray(ls->getType())) {
-        if (isTypeArray(rs->getType())) {
-          dynamic_cast<Lvalue*>(ls.get())->setValue(
-              std::make_unique<ArrayRvalue>(*dynamic_cast<const ArrayRvalue*>(rs->getRvalue()))
-          );
-        } else {
-          dynamic_cast<Lvalue*>(ls.get())->setValue(
-              std::make_unique<ArrayRvalue>(TYPE_ARRAY(getListElementType(rs->getType())),
-                  dynamic_cast<const ListRvalue*>(rs->getRvalue())->getValue())
-          );
-        }
+      if (isTypeArray(ls->getType()) && isTypeList(rs->getType())) {
+        dynamic_cast<Lvalue*>(ls.get())->setValue(
+            std::make_unique<ArrayRvalue>(TYPE_ARRAY(getListElementType(rs->getType())),
+                dynamic_cast<const ListRvalue*>(rs->getRvalue())->getValue())
+        );
+      } else {
+        dynamic_cast<Lvalue*>(ls.get())->setValue(copyRvalue(rs->getRvalue()));
       }
       return ls;
     case BinaryOperatorNode::ADD_ASSIGN:
@@ -428,34 +835,70 @@ std::unique_ptr<Value> VirtualMachine::evalExp(ExpressionNode* node) {
         return std::make_unique<StringRvalue>(ans);
       } else {
         auto arr = dynamic_cast<const ArrayRvalue*>(ls->getRvalue());
-        int arrSize = static_cast<int>(arr->getValue()->size());
+        int arrSize = static_cast<int>(arr->getSize());
         if (ii < 0) {
           ii += arrSize;
         }
         if (ii < 0 || ii >= arrSize) {
           throw RuntimeError("array index out of bounds");
         }
+        if (arr->getNumbers() != nullptr) {
+          if (ls->getMemoryClass() == Value::LVALUE) {
+            return std::make_unique<NumberElementLvalue>(store, dynamic_cast<const Lvalue*>(ls.get())->name,
+                                                         std::vector<int>(1, ii), arr->getNumbers()[ii]);
+          }
+          return std::make_unique<NumberRvalue>(arr->getNumbers()[ii]);
+        }
         if (ls->getMemoryClass() == Value::LVALUE) {
-          return std::make_unique<ElementLvalue>(dynamic_cast<const Lvalue*>(ls.get())->name, std::vector<int>(1, ii));
+          return std::make_unique<ElementLvalue>(store, dynamic_cast<const Lvalue*>(ls.get())->name,
+                                                 std::vector<int>(1, ii));
           // TODO: make it work for nested arrays
         }
-        const auto& elem = dynamic_cast<ArrayRvalue*>(ls.get())->getValue()->at(ii);
-        if (elem->getType() == TYPE_BOOLEAN) {
-          return std::make_unique<BooleanRvalue>(dynamic_cast<BooleanRvalue*>(elem.get())->getValue());
-        }
-        if (elem->getType() == TYPE_NUMBER) {
-          return std::make_unique<NumberRvalue>(dynamic_cast<NumberRvalue*>(elem.get())->getValue());
-        }
-        if (elem->getType() == TYPE_STRING) {
-          return std::make_unique<StringRvalue>(dynamic_cast<StringRvalue*>(elem.get())->getValue());
-        }
-        if (isTypeArray(elem->getType())) {
-          return std::make_unique<ArrayRvalue>(*dynamic_cast<ArrayRvalue*>(elem.get()));
-        }
+        return copyRvalue(dynamic_cast<ArrayRvalue*>(ls.get())->getValue()->at(ii).get());
       }
   }
 }
 
+std::unique_ptr<Rvalue> VirtualMachine::copyRvalue(const Rvalue* value) {
+  int type = value->getType();
+  if (type == TYPE_BOOLEAN) {
+    return std::make_unique<BooleanRvalue>(dynamic_cast<const BooleanRvalue*>(value)->getValue());
+  }
+  if (type == TYPE_NUMBER) {
+    return std::make_unique<NumberRvalue>(dynamic_cast<const NumberRvalue*>(value)->getValue());
+  }
+  if (type == TYPE_STRING) {
+    return std::make_unique<StringRvalue>(dynamic_cast<const StringRvalue*>(value)->getValue());
+  }
+  if (isTypeTask(type)) {
+    return std::make_unique<TaskRvalue>(*dynamic_cast<const TaskRvalue*>(value));
+  }
+  if (isTypeChannel(type)) {
+    return std::make_unique<ChannelRvalue>(*dynamic_cast<const ChannelRvalue*>(value));
+  }
+  if (type == TYPE_LINES) {
+    return std::make_unique<LinesRvalue>(*dynamic_cast<const LinesRvalue*>(value));
+  }
+  if (type == TYPE_WRITER) {
+    return std::make_unique<WriterRvalue>(*dynamic_cast<const WriterRvalue*>(value));
+  }
+  return std::make_unique<ArrayRvalue>(*dynamic_cast<const ArrayRvalue*>(value));
+}
+
+std::unique_ptr<Rvalue> VirtualMachine::cloneRvalue(const Rvalue* value) {
+  if (!isTypeArray(value->getType())) {
+    return copyRvalue(value);
+  }
+  if (dynamic_cast<const ArrayRvalue*>(value)->getNumbers() != nullptr) {
+    return std::make_unique<ArrayRvalue>(dynamic_cast<const ArrayRvalue*>(value)->getFile());
+  }
+  std::vector<std::shared_ptr<Rvalue>> elements;
+  for (const auto& element : *dynamic_cast<const ArrayRvalue*>(value)->getValue()) {
+    elements.push_back(cloneRvalue(element.get()));
+  }
+  return std::make_unique<ArrayRvalue>(value->getType(), std::move(elements));
+}
+
 bool VirtualMachine::getBooleanValue(const std::unique_ptr<Value>& value) {
   return dynamic_cast<const BooleanRvalue*>(value->getRvalue())->getValue();
 }
@@ -464,6 +907,35 @@ double VirtualMachine::getNumberValue(const std::unique_ptr<Value>& value) {
   return dynamic_cast<const NumberRvalue*>(value->getRvalue())->getValue();
 }
 
-std::string VirtualMachine::getStringValue(const std::unique_ptr<Value>& value) {
+const std::string& VirtualMachine::getStringValue(const std::unique_ptr<Value>& value) {
   return dynamic_cast<const StringRvalue*>(value->getRvalue())->getValue();
 }
+
+std::vector<double> VirtualMachine::getNumberArray(const std::unique_ptr<Value>& value) {
+  auto array = dynamic_cast<const ArrayRvalue*>(value->getRvalue());
+  if (array->getNumbers() != nullptr) {
+    return std::vector<double>(array->getNumbers(), array->getNumbers() + array->getSize());
+  }
+  const auto& elements = *dynamic_cast<const ArrayRvalue*>(value->getRvalue())->getValue();
+  std::vector<double> numbers(elements.size());
+  for (size_t i = 0; i < elements.size(); ++i) {
+    numbers[i] = static_cast<const NumberRvalue*>(elements[i].get())->getValue();
+  }
+  return numbers;
+}
+
+const std::shared_ptr<FileWriter>& VirtualMachine::getWriter(const std::unique_ptr<Value>& value) {
+  const auto& writer = dynamic_cast<const WriterRvalue*>(value->getRvalue())->getWriter();
+  if (!writer) {
+    throw RuntimeError("file writer was never opened");
+  }
+  return writer;
+}
+
+const std::shared_ptr<Channel>& VirtualMachine::getChannel(const std::unique_ptr<Value>& value) {
+  const auto& channel = dynamic_cast<const ChannelRvalue*>(value->getRvalue())->getChannel();
+  if (!channel) {
+    throw RuntimeError("channel was never created");
+  }
+  return channel;
+}
@@ -1,18 +1,41 @@
 #ifndef PROG_LANG_VM_H
 #define PROG_LANG_VM_H
 
+#include <iostream>
+
 #include "node.h"
 #include "value.h"
 
+class Context;
+class FunctionData;
+class Store;
+
 class VirtualMachine {
  public:
-  static std::pair<bool, std::unique_ptr<Value>> run(Node* node);
+  explicit VirtualMachine(Context& context);
+  std::pair<bool, std::unique_ptr<Value>> run(Node* node);
+  std::unique_ptr<Value> call(FunctionData* function, std::vector<std::unique_ptr<Value>> arguments);
+  // copies a value the way assignment does: arrays, tasks, channels and files keep sharing what they refer to
+  static std::unique_ptr<Rvalue> copyRvalue(const Rvalue* value);
 
  private:
-  static std::unique_ptr<Value> evalExp(ExpressionNode* node);
+  void readArray(const std::unique_ptr<Value>& array, double count);
+  void runParallel(ForNode* node, const Value* range);
+  std::unique_ptr<Value> spawn(SpawnNode* node);
+  std::unique_ptr<Value> await(AwaitNode* node);
+  std::unique_ptr<Value> evalExp(ExpressionNode* node);
+  static std::unique_ptr<Rvalue> cloneRvalue(const Rvalue* value);
   static bool getBooleanValue(const std::unique_ptr<Value>& value);
   static double getNumberValue(const std::unique_ptr<Value>& value);
-  static std::string getStringValue(const std::unique_ptr<Value>& value);
+  static const std::string& getStringValue(const std::unique_ptr<Value>& value);
+  static std::vector<double> getNumberArray(const std::unique_ptr<Value>& value);
+  static const std::shared_ptr<Channel>& getChannel(const std::unique_ptr<Value>& value);
+  static const std::shared_ptr<FileWriter>& getWriter(const std::unique_ptr<Value>& value);
+
+  Context& context;
+  Store& store;
+  std::istream& input;
+  std::ostream& output;
 };
 
 #endif //PROG_LANG_VM_H
@@ -0,0 +1,110 @@
+#include <atomic>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "error.h"
+#include "program.h"
+
+// Runs many scripts at once on separate threads and checks that every run sees only its own globals, input,
+// arguments and output
+
+namespace {
+const int THREADS = 16;
+const int ROUNDS = 20;
+
+// every run declares the same global and function names with values of its own
+std::string makeSource(int id) {
+  return "counter := " + std::to_string(id) + "\n"
+         "name := \"script" + std::to_string(id) + "\"\n"
+         "step: (n: number): number\n"
+         "  counter += n\n"
+         "  return counter\n"
+         "i := 0\n"
+         "while i < 200\n"
+         "  step(1)\n"
+         "  i += 1\n"
+         "print name\n"
+         "print counter\n";
+}
+
+std::string expectedOutput(int id) {
+  return "script" + std::to_string(id) + "\n" + std::to_string(id + 200) + "\n";
+}
+
+// one compiled program shared by all threads, run with different input and arguments
+const char* SHARED_SOURCE =
+    "total := 0\n"
+    "x: number\n"
+    "read x\n"
+    "values: array<number>\n"
+    "i := 0\n"
+    "while i < x\n"
+    "  add(values, i)\n"
+    "  i += 1\n"
+    "for v : values\n"
+    "  total += v\n"
+    "print args[0]\n"
+    "print total\n";
+
+std::string sharedExpected(int id) {
+  int n = 50 + id;
+  return "run" + std::to_string(id) + "\n" + std::to_string(n * (n - 1) / 2) + "\n";
+}
+
+std::atomic<int> failures(0);
+
+void check(const std::string& what, const std::string& actual, const std::string& expected) {
+  if (actual != expected) {
+    ++failures;
+    std::cerr << what << ": expected\n" << expected << "got\n" << actual << "\n";
+  }
+}
+}
+
+int main() {
+  auto shared = Program::compileSource(SHARED_SOURCE, "shared");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; ++t) {
+    threads.emplace_back([t, &shared]() {
+      for (int round = 0; round < ROUNDS; ++round) {
+        int id = t * ROUNDS + round;
+        try {
+          std::istringstream input;
+          std::ostringstream output;
+          Program::compileSource(makeSource(id), "script" + std::to_string(id))->run(input, output);
+          check("separate program " + std::to_string(id), output.str(), expectedOutput(id));
+
+          std::istringstream sharedInput(std::to_string(50 + id));
+          std::ostringstream sharedOutput;
+          shared->run(sharedInput, sharedOutput, {"run" + std::to_string(id)});
+          check("shared program " + std::to_string(id), sharedOutput.str(), sharedExpected(id));
+
+          // a failing run must not disturb the others
+          std::istringstream failingInput;
+          std::ostringstream failingOutput;
+          try {
+            Program::compileSource("print \"before\"\nx := 1 / 0\n")->run(failingInput, failingOutput);
+            check("failing program " + std::to_string(id), "no error", "runtime error");
+          } catch (Error&) {
+            check("failing program " + std::to_string(id), failingOutput.str(), "before\n");
+          }
+        } catch (std::exception& e) {
+          ++failures;
+          std::cerr << "run " << id << " threw " << e.what() << "\n";
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (failures > 0) {
+    std::cerr << failures << " checks failed\n";
+    return 1;
+  }
+  std::cout << "all " << THREADS * ROUNDS << " runs isolated\n";
+  return 0;
+}
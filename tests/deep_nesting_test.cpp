@@ -0,0 +1,129 @@
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "error.h"
+#include "program.h"
+
+// Compiles deeply nested lists and expressions at two sizes and checks that the compile time grows linearly with
+// the nesting, so that no phase walks a subtree more than once per node
+
+namespace {
+const int SMALL = 250;
+const int LARGE = 4 * SMALL;
+const int REPEATS = 5;
+// a single small compile takes well under a millisecond, so every measurement times a batch of them to stay far
+// above the timer and scheduler resolution
+const int COMPILES_PER_RUN = 20;
+// linear growth gives 4x from SMALL to LARGE and quadratic 16x; leave room for timer noise in between
+const double MAX_RATIO = 8.0;
+const double MAX_SECONDS = 1.0;
+// the deepest list literal whose type still fits in the type encoding; only the outermost level of a list literal
+// becomes an array at run time, so the list shapes check compilation and a clean run but not the contents
+const int MAX_LIST_DEPTH = 9;
+
+struct Shape {
+  const char* name;
+  std::function<std::string(int)> source;
+  std::function<std::string(int)> expected;
+};
+
+std::string repeat(const std::string& s, int n) {
+  std::string ans;
+  for (int i = 0; i < n; ++i) {
+    ans += s;
+  }
+  return ans;
+}
+
+std::string nestedList(int depth, const std::string& leaf) {
+  return repeat("[", depth) + leaf + repeat("]", depth);
+}
+
+const std::vector<Shape> SHAPES = {
+    {"parenthesized expression",
+     [](int n) { return "y := " + repeat("(", n) + "1" + repeat(" + 1)", n) + "\nprint y\n"; },
+     [](int n) { return std::to_string(n + 1) + "\n"; }},
+    {"operator chain",
+     [](int n) { return "y := 1" + repeat(" + 2 * 3 - 6", n) + "\nprint y\n"; },
+     [](int) { return "1\n"; }},
+    {"unary operators",
+     [](int n) { return "y := " + repeat("- ", 2 * n) + "1\nprint y\n"; },
+     [](int) { return "1\n"; }},
+    {"nested calls",
+     [](int n) { return "f: (x: number): number\n  return x + 1\ny := " + repeat("f(", n) + "0" + repeat(")", n) +
+                        "\nprint y\n"; },
+     [](int n) { return std::to_string(n) + "\n"; }},
+    {"nested lists",
+     [](int n) {
+       std::string elements = nestedList(MAX_LIST_DEPTH - 1, "1");
+       for (int i = 1; i < n; ++i) {
+         elements += ", " + nestedList(MAX_LIST_DEPTH - 1, std::to_string(i + 1));
+       }
+       return "y := [" + elements + "]\nprint \"done\"\n";
+     },
+     [](int) { return "done\n"; }},
+    {"lists around a deep expression",
+     [](int n) { return "y := " + nestedList(MAX_LIST_DEPTH, repeat("(", n) + "1" + repeat(" + 1)", n)) +
+                        "\nprint \"done\"\n"; },
+     [](int) { return "done\n"; }},
+};
+
+double compileSeconds(const std::string& source) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < COMPILES_PER_RUN; ++i) {
+    Program::compileSource(source);
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / COMPILES_PER_RUN;
+}
+
+bool check(const Shape& shape) {
+  std::istringstream input;
+  std::ostringstream output;
+  Program::compileSource(shape.source(LARGE))->run(input, output);
+  if (output.str() != shape.expected(LARGE)) {
+    std::cerr << shape.name << ": expected\n" << shape.expected(LARGE) << "got\n" << output.str() << "\n";
+    return false;
+  }
+  // the sizes alternate so that a burst of load on the machine slows both alike, and the fastest run of each counts
+  auto smallSource = shape.source(SMALL);
+  auto largeSource = shape.source(LARGE);
+  double small = compileSeconds(smallSource);
+  double large = compileSeconds(largeSource);
+  for (int i = 1; i < REPEATS; ++i) {
+    small = std::min(small, compileSeconds(smallSource));
+    large = std::min(large, compileSeconds(largeSource));
+  }
+  double ratio = large / small;
+  std::cout << shape.name << ": " << small << " s at " << SMALL << ", " << large << " s at " << LARGE << "\n";
+  if (ratio > MAX_RATIO || large > MAX_SECONDS) {
+    std::cerr << shape.name << ": compile time grows faster than the nesting (" << ratio << "x)\n";
+    return false;
+  }
+  return true;
+}
+}
+
+int main() {
+  int failures = 0;
+  for (const auto& shape : SHAPES) {
+    try {
+      if (!check(shape)) {
+        ++failures;
+      }
+    } catch (Error& e) {
+      ++failures;
+      std::cerr << shape.name << " failed: " << e.what() << "\n";
+    }
+  }
+  if (failures > 0) {
+    std::cerr << failures << " shapes failed\n";
+    return 1;
+  }
+  std::cout << "all " << SHAPES.size() << " shapes compile in linear time\n";
+  return 0;
+}
@@ -0,0 +1,132 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "error.h"
+#include "incremental_checker.h"
+
+// Checks a sequence of edited versions of one source with a single incremental checker and compares every result,
+// reported line numbers included, with the expected one and with a checker that sees the version for the first time
+
+namespace {
+struct Version {
+  const char* description;
+  std::vector<std::string> lines;
+  std::string expected;
+};
+
+const std::vector<Version> VERSIONS = {
+    {"initial version",
+     {"x := 1",
+      "double: (n: number): number",
+      "  return n * 2",
+      "count := 0",
+      "count += 1",
+      "count += 1",
+      "y := double(x)"},
+     "OK"},
+    {"syntax error below unchanged chunks",
+     {"x := 1",
+      "double: (n: number): number",
+      "  return n * 2",
+      "count := 0",
+      "count += 1",
+      "count += 1",
+      "y := double(x) +"},
+     "Syntax error (line 7, col 17): expected open parenthesis, unary operator or operand"},
+    {"lines inserted above the error",
+     {"label := \"start\"",
+      "flag := true",
+      "x := 1",
+      "double: (n: number): number",
+      "  return n * 2",
+      "count := 0",
+      "count += 1",
+      "count += 1",
+      "y := double(x) +"},
+     "Syntax error (line 9, col 17): expected open parenthesis, unary operator or operand"},
+    {"error fixed, repeated chunks moved",
+     {"label := \"start\"",
+      "count := 0",
+      "count += 1",
+      "flag := true",
+      "count += 1",
+      "x := 1",
+      "count += 1",
+      "double: (n: number): number",
+      "  return n * 2",
+      "y := double(x)"},
+     "OK"},
+    {"error inside a repeated chunk",
+     {"label := \"start\"",
+      "count := 0",
+      "count += 1",
+      "flag := true",
+      "count += 1",
+      "x := 1",
+      "count += )",
+      "double: (n: number): number",
+      "  return n * 2",
+      "y := double(x)"},
+     "Syntax error (line 7, col 10): expected open parenthesis, unary operator or operand"},
+    {"lines removed above the error",
+     {"count := 0",
+      "count += )",
+      "x := 1",
+      "double: (n: number): number",
+      "  return n * 2",
+      "y := double(x)"},
+     "Syntax error (line 2, col 10): expected open parenthesis, unary operator or operand"},
+    {"unchanged call after its function changed",
+     {"count := 0",
+      "x := 1",
+      "double: (n: string): number",
+      "  return 2",
+      "y := double(x)"},
+     "Semantic error: argument type does not match"},
+    {"unchanged use after its variable changed type",
+     {"count := 0",
+      "x := \"one\"",
+      "double: (n: number): number",
+      "  return n * 2",
+      "y := double(x)"},
+     "Semantic error: argument type does not match"},
+    {"back to a valid version",
+     {"count := 0",
+      "x := 1",
+      "double: (n: number): number",
+      "  return n * 2",
+      "y := double(x)"},
+     "OK"},
+};
+
+std::string check(IncrementalChecker& checker, const std::vector<std::string>& lines) {
+  try {
+    checker.check(lines);
+    return "OK";
+  } catch (Error& e) {
+    return e.toString();
+  }
+}
+}
+
+int main() {
+  int failures = 0;
+  IncrementalChecker checker;
+  for (const auto& version : VERSIONS) {
+    IncrementalChecker fresh;
+    auto freshResult = check(fresh, version.lines);
+    auto actual = check(checker, version.lines);
+    if (actual != version.expected || freshResult != version.expected) {
+      ++failures;
+      std::cerr << version.description << ": expected " << version.expected << "\ngot " << actual
+                << "\nand from a fresh checker " << freshResult << "\n";
+    }
+  }
+  if (failures > 0) {
+    std::cerr << failures << " versions failed\n";
+    return 1;
+  }
+  std::cout << "all " << VERSIONS.size() << " versions checked\n";
+  return 0;
+}
@@ -0,0 +1,135 @@
+#include <unistd.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "error.h"
+#include "program.h"
+
+// Imports the modules in the fixture directory given as the argument and checks what a single script can not:
+// cyclic imports, module globals that start afresh in every run of one program, and modules reloaded after an edit
+
+namespace {
+const int THREADS = 8;
+
+int failures = 0;
+
+void check(const std::string& what, const std::string& actual, const std::string& expected) {
+  if (actual != expected) {
+    ++failures;
+    std::cerr << what << ": expected\n" << expected << "got\n" << actual << "\n";
+  }
+}
+
+std::string compileError(const std::string& source, const std::string& fileName) {
+  try {
+    Program::compileSource(source, fileName);
+    return "no error";
+  } catch (Error& e) {
+    return e.toString();
+  }
+}
+
+std::string run(const Program& program) {
+  std::istringstream input;
+  std::ostringstream output;
+  program.run(input, output);
+  return output.str();
+}
+
+// the timestamp moves forward explicitly, since a rewrite within the clock resolution would not change it
+void writeModule(const std::filesystem::path& path, const std::string& source) {
+  bool existed = std::filesystem::exists(path);
+  auto previous = existed ? std::filesystem::last_write_time(path) : std::filesystem::file_time_type();
+  std::ofstream(path) << source;
+  if (existed) {
+    std::filesystem::last_write_time(path, previous + std::chrono::seconds(1));
+  }
+}
+
+void checkCycles(const std::filesystem::path& fixtures) {
+  std::string main = (fixtures / "main.pl").string();
+  std::string cycleA = std::filesystem::weakly_canonical(fixtures / "cycle_a.pl").string();
+  std::string cycleB = std::filesystem::weakly_canonical(fixtures / "cycle_b.pl").string();
+  check("cycle", compileError("import \"cycle_a.pl\"\n", main), "Semantic error: cyclic import of module " + cycleA);
+  // the failed analysis must not leave the modules marked as being analyzed
+  check("same cycle again", compileError("import \"cycle_a.pl\"\n", main),
+        "Semantic error: cyclic import of module " + cycleA);
+  check("cycle entered from the other module", compileError("import \"cycle_b.pl\"\n", main),
+        "Semantic error: cyclic import of module " + cycleB);
+}
+
+void checkGlobalsPerRun(const std::filesystem::path& fixtures) {
+  auto program = Program::compileSource("import \"left.pl\"\nimport \"right.pl\"\nprint leftNext()\n"
+                                        "print rightNext()\n", (fixtures / "main.pl").string());
+  const std::string expected = "counter loaded\n1\n2\n";
+  for (int i = 0; i < 3; ++i) {
+    check("run " + std::to_string(i), run(*program), expected);
+  }
+  std::vector<std::string> outputs(THREADS);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; ++t) {
+    threads.emplace_back([t, &program, &outputs]() { outputs[t] = run(*program); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < THREADS; ++t) {
+    check("concurrent run " + std::to_string(t), outputs[t], expected);
+  }
+}
+
+void checkReload() {
+  auto directory = std::filesystem::temp_directory_path() / ("modules-test-" + std::to_string(getpid()));
+  std::filesystem::create_directories(directory);
+  std::string main = (directory / "main.pl").string();
+  const std::string source = "import \"middle.pl\"\nprint get()\n";
+  writeModule(directory / "base.pl", "value := 1\n");
+  writeModule(directory / "middle.pl", "import \"base.pl\"\nget: (): number\n  return value\n");
+  auto first = Program::compileSource(source, main);
+  check("before the edit", run(*first), "1\n");
+
+  // only the module imported indirectly changes, so the one in between must be reloaded because of it
+  writeModule(directory / "base.pl", "value := 2\n");
+  auto second = Program::compileSource(source, main);
+  check("after editing the indirect import", run(*second), "2\n");
+  check("program compiled before the edit", run(*first), "1\n");
+
+  writeModule(directory / "middle.pl", "import \"base.pl\"\nget: (): number\n  return value * 10\n");
+  check("after editing the direct import", run(*Program::compileSource(source, main)), "20\n");
+
+  writeModule(directory / "base.pl", "value := \"text\"\n");
+  check("edit that breaks the importer", compileError(source, main), "Semantic error: invalid operands");
+  std::filesystem::remove(directory / "base.pl");
+  check("removed module", compileError(source, main), "Semantic error: can not open module base.pl");
+  std::filesystem::remove_all(directory);
+}
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    std::cerr << "usage: " << argv[0] << " <fixture directory>\n";
+    return 2;
+  }
+  std::filesystem::path fixtures = argv[1];
+  try {
+    checkCycles(fixtures);
+    checkGlobalsPerRun(fixtures);
+    checkReload();
+  } catch (std::exception& e) {
+    ++failures;
+    std::cerr << "unexpected error: " << e.what() << "\n";
+  }
+  if (failures > 0) {
+    std::cerr << failures << " checks failed\n";
+    return 1;
+  }
+  std::cout << "all module checks passed\n";
+  return 0;
+}
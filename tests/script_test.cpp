@@ -0,0 +1,99 @@
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Runs one script through the interpreter and compares everything it prints, errors included, with the script's
+// .expected file. Standard input comes from the script's .in file when there is one, and the interpreter options,
+// one per line, from its .args file
+
+namespace {
+bool readFile(const std::string& path, std::string& content) {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+  content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  return true;
+}
+
+std::string withoutExtension(const std::string& path) {
+  auto dot = path.rfind('.');
+  return dot == std::string::npos ? path : path.substr(0, dot);
+}
+}
+
+int main(int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "usage: " << argv[0] << " <interpreter> <script>\n";
+    return 2;
+  }
+  std::string interpreter = argv[1];
+  std::string script = argv[2];
+  std::string base = withoutExtension(script);
+  std::string expected;
+  if (!readFile(base + ".expected", expected)) {
+    std::cerr << "can not open " << base << ".expected\n";
+    return 2;
+  }
+  std::string inputPath = access((base + ".in").c_str(), R_OK) == 0 ? base + ".in" : "/dev/null";
+  std::vector<std::string> options;
+  std::ifstream optionsFile(base + ".args");
+  for (std::string option; std::getline(optionsFile, option);) {
+    if (!option.empty()) {
+      options.push_back(option);
+    }
+  }
+  std::vector<char*> command{&interpreter[0]};
+  for (auto& option : options) {
+    command.push_back(&option[0]);
+  }
+  command.push_back(&script[0]);
+  command.push_back(nullptr);
+  // the scripts write their scratch files to the working directory, so the output goes next to them
+  auto slash = base.rfind('/');
+  std::string outputPath = base.substr(slash == std::string::npos ? 0 : slash + 1) + ".out";
+  pid_t pid = fork();
+  if (pid < 0) {
+    std::cerr << "fork: " << std::strerror(errno) << "\n";
+    return 2;
+  }
+  if (pid == 0) {
+    int input = open(inputPath.c_str(), O_RDONLY);
+    int output = open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (input < 0 || output < 0) {
+      _exit(127);
+    }
+    dup2(input, STDIN_FILENO);
+    dup2(output, STDOUT_FILENO);
+    dup2(output, STDERR_FILENO);
+    execv(interpreter.c_str(), command.data());
+    _exit(127);
+  }
+  int status = 0;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      std::cerr << "waitpid: " << std::strerror(errno) << "\n";
+      return 2;
+    }
+  }
+  std::string actual;
+  readFile(outputPath, actual);
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    std::cerr << script << ": interpreter exited abnormally\n" << actual;
+    return 1;
+  }
+  if (actual != expected) {
+    std::cerr << script << ": expected\n" << expected << "got\n" << actual;
+    return 1;
+  }
+  std::remove(outputPath.c_str());
+  return 0;
+}
@@ -0,0 +1,2 @@
+numbers := [1, 2, 3]
+print binarySearch(numbers, "2")
@@ -0,0 +1,19 @@
+n: number
+read n
+values: array<number>
+read values, n
+print size(values)
+print sum(values)
+print values[n - 1]
+names: array<string>
+read names, 3
+for name : names
+  print name
+flag: boolean
+read flag
+print flag
+rest: array<number>
+read rest, 0
+print size(rest)
+more: array<string>
+read more, 2
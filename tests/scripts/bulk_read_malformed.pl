@@ -0,0 +1,2 @@
+values: array<number>
+read values, 3
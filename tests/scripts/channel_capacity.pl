@@ -0,0 +1 @@
+c := channel<number>(0)
@@ -0,0 +1,3 @@
+c := channel<number>(1)
+close(c)
+send(c, 1)
@@ -0,0 +1,34 @@
+produce: (out: channel<number>, count: number)
+  i := 1
+  while i <= count
+    send(out, i)
+    i += 1
+  close(out)
+relay: (input: channel<number>, out: channel<number>)
+  for x : input
+    send(out, x * 2)
+  close(out)
+first := channel<number>(1)
+second := channel<number>(1)
+p := spawn produce(first, 500)
+r := spawn relay(first, second)
+count := 0
+total := 0
+last := 0
+ordered := true
+for x : second
+  count += 1
+  total += x
+  if x <= last
+    ordered = false
+  last = x
+await p
+await r
+print count
+print total
+print ordered
+words := channel<string>(1)
+send(words, "only")
+close(words)
+print receive(words)
+print receive(words)
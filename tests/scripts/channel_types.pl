@@ -0,0 +1,2 @@
+c := channel<number>(1)
+send(c, "one")
@@ -0,0 +1,27 @@
+produce: (out: channel<number>, count: number)
+  i := 1
+  while i <= count
+    send(out, i)
+    i += 1
+  close(out)
+square: (input: channel<number>, out: channel<number>)
+  for x : input
+    send(out, x * x)
+  close(out)
+numbers := channel<number>(4)
+squares := channel<number>(2)
+p := spawn produce(numbers, 100)
+s := spawn square(numbers, squares)
+total := 0
+for x : squares
+  total += x
+await p
+await s
+print total
+words := channel<string>(3)
+send(words, "first")
+send(words, "second")
+print receive(words)
+close(words)
+print receive(words)
+print receive(words)
@@ -0,0 +1,12 @@
+count := 0
+total := 0
+print "top level"
+begin: ()
+  print "begin"
+handle: (line: string)
+  count += 1
+  total += len(line)
+  print toString(count) + ": " + line
+end: ()
+  print "lines " + toString(count)
+  print total
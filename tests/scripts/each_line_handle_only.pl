@@ -0,0 +1,3 @@
+handle: (line: string)
+  words := split(line, " ")
+  print size(words)
@@ -0,0 +1,2 @@
+handle: (line: number)
+  print line
@@ -0,0 +1,3 @@
+print "top level"
+begin: ()
+  print "begin"
@@ -0,0 +1,2 @@
+import "modules/missing.pl"
+print "unreachable"
@@ -0,0 +1,9 @@
+import "modules/geometry.pl"
+import "modules/left.pl"
+import "modules/right.pl"
+print area(2, 3)
+print leftNext()
+print rightNext()
+print leftNext()
+import "modules/left.pl"
+print leftNext()
@@ -0,0 +1,27 @@
+values: array<number>
+i := 0
+while i < 1000
+  add(values, (999 - i) * 0.5)
+  i += 1
+saveNumbers("load_numbers.bin", values)
+loaded := loadNumbers("load_numbers.bin")
+print size(loaded)
+print loaded[999]
+print sum(loaded) == sum(values)
+alias := loaded
+loaded[0] = 42
+add(loaded, 7)
+print loaded[0]
+print alias[0]
+print size(alias)
+again := loadNumbers("load_numbers.bin")
+print again[0]
+print size(again)
+sort(again)
+print again[0]
+second := loadNumbers("load_numbers.bin")
+print second[999]
+empty: array<number>
+saveNumbers("load_numbers_empty.bin", empty)
+print size(loadNumbers("load_numbers_empty.bin"))
+print size(loadNumbers("load_numbers_missing.bin"))
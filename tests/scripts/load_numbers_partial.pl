@@ -0,0 +1,4 @@
+out := openWrite("load_numbers_partial.bin")
+write(out, "12345")
+close(out)
+x := loadNumbers("load_numbers_partial.bin")
@@ -0,0 +1,2 @@
+names := ["a"]
+saveNumbers("load_numbers_types.bin", names)
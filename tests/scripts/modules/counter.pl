@@ -0,0 +1,5 @@
+count := 0
+print "counter loaded"
+next: (): number
+  count += 1
+  return count
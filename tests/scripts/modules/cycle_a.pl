@@ -0,0 +1,2 @@
+import "cycle_b.pl"
+a := 1
@@ -0,0 +1,2 @@
+import "cycle_a.pl"
+b := 2
@@ -0,0 +1,3 @@
+import "constants.pl"
+area: (w: number, h: number): number
+  return w * h * scale
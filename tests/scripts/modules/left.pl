@@ -0,0 +1,3 @@
+import "counter.pl"
+leftNext: (): number
+  return next()
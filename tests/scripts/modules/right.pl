@@ -0,0 +1,3 @@
+import "counter.pl"
+rightNext: (): number
+  return next()
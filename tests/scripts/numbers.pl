@@ -0,0 +1,16 @@
+print 0.1 + 0.2
+print 1 / 3
+print 100
+print -0.5
+print 1000000 * 1000000
+print 123456789012345678901234567890
+print 0.000001
+print 2 / 0.0000000000000000001
+print toString(2.5) + "!"
+print toString(-7)
+print toNumber("42") + 1
+print toNumber("  3.25")
+print toNumber("-1e3")
+print toNumber("0.1") + toNumber("0.2") == 0.1 + 0.2
+print toNumber(toString(1 / 7)) == 1 / 7
+print toNumber("12abc")
@@ -0,0 +1,48 @@
+square: (x: number): number
+  return x * x
+values := [1, 2, 3, 4, 5, 6, 7, 8, 9, 10]
+parallel for x : values
+  x = square(x) + 1
+print sum(values)
+print values[0]
+print values[9]
+words := ["a", "bc", "def"]
+parallel for w : words
+  w = w + w
+print words[0] + " " + words[1] + " " + words[2]
+grid := [1, 2, 3]
+parallel for row : grid
+  cells := [1, 2, 3, 4]
+  parallel for cell : cells
+    cell = cell * row
+  row = sum(cells)
+print grid[0]
+print grid[1]
+print grid[2]
+parallel for c : "abc"
+  c = c + "!"
+parallel for n : [1, 2, 3]
+  local := n * 2
+  n = local
+scratch := [5, 6]
+parallel for s : scratch
+  copy := [s, s]
+  add(copy, s)
+  s = sum(copy)
+print scratch[0]
+print scratch[1]
+empty: array<number>
+parallel for e : empty
+  e = 1
+print size(empty)
+large: array<number>
+i := 0
+while i < 10000
+  add(large, i)
+  i += 1
+parallel for v : large
+  v = v * 2
+print sum(large)
+print large[9999]
+parallel for d : values
+  d = large[d * 1000]
@@ -0,0 +1,5 @@
+values := [1, 2, 3]
+total := 0
+parallel for x : values
+  total += x
+print total
@@ -0,0 +1,8 @@
+report: (x: number): number
+  print x
+  return x
+scaled: (x: number): number
+  return report(x) * 2
+values := [1, 2, 3]
+parallel for x : values
+  x = scaled(x)
@@ -0,0 +1,5 @@
+grow: (a: array<number>)
+  add(a, 0)
+values := [1, 2, 3]
+parallel for x : values
+  grow(values)
@@ -0,0 +1,3 @@
+numbers := channel<number>(2)
+parallel for x : numbers
+  x = x + 1
@@ -0,0 +1,4 @@
+values := [1, 2, 3]
+parallel for x : values
+  alias := values
+  add(alias, x)
@@ -0,0 +1,3 @@
+values := [1, 2, 3]
+parallel for x : values
+  read x
@@ -0,0 +1,6 @@
+first: (values: array<number>): number
+  parallel for x : values
+    return x
+  return 0
+numbers := [1, 2]
+print first(numbers)
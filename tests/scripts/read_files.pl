@@ -0,0 +1,25 @@
+paths: array<string>
+i := 0
+while i < 20
+  path := "read_files_" + toString(i) + ".txt"
+  out := openWrite(path)
+  write(out, "file " + toString(i))
+  close(out)
+  add(paths, path)
+  i += 1
+contents := readFiles(paths)
+print size(contents)
+print contents[0]
+print contents[19]
+total := 0
+for c : contents
+  total += len(c)
+print total
+empty: array<string>
+print size(readFiles(empty))
+count: (names: array<string>): number
+  return size(readFiles(names))
+t := spawn count(paths)
+print await t
+missing := ["read_files_3.txt", "read_files_missing_b.txt", "read_files_missing_a.txt"]
+print size(readFiles(missing))
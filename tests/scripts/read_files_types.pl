@@ -0,0 +1,2 @@
+numbers := [1, 2]
+c := readFiles(numbers)
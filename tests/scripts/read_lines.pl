@@ -0,0 +1,23 @@
+out := openWrite("read_lines.txt")
+writeLine(out, "alpha")
+writeLine(out, "")
+write(out, "gamma delta")
+close(out)
+lines := readLines("read_lines.txt")
+count := 0
+for line : lines
+  count += 1
+  print "[" + line + "]"
+print count
+again := 0
+for line : lines
+  again += len(line)
+print again
+content := readFile("read_lines.txt")
+print len(content)
+empty := openWrite("read_lines_empty.txt")
+close(empty)
+for line : readLines("read_lines_empty.txt")
+  print "unexpected"
+print len(readFile("read_lines_empty.txt"))
+print readFile("read_lines_missing.txt")
@@ -0,0 +1,2 @@
+for line : readLines("read_lines_missing.txt")
+  print line
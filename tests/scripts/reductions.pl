@@ -0,0 +1,20 @@
+values := [4, -1.5, 10, 2.5]
+print sum(values)
+print min(values)
+print max(values)
+print mean(values)
+ones := [1, 1, 1, 1]
+print dot(values, ones)
+squares: array<number>
+i := 0
+while i < 1000
+  add(squares, i)
+  i += 1
+print sum(squares)
+print dot(squares, squares)
+print max(squares)
+empty: array<number>
+print sum(empty)
+print dot(empty, empty)
+pair := [1, 2]
+print dot(values, pair)
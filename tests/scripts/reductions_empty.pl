@@ -0,0 +1,2 @@
+empty: array<number>
+print min(empty)
@@ -0,0 +1,18 @@
+nan := toNumber("nan")
+middle := [1, 2, 3, 4, nan, 5, 6, 7, 8]
+print min(middle)
+print max(middle)
+print sum(middle)
+first := [nan, 1, 2, 3, 4, 5, 6, 7]
+print min(first)
+print max(first)
+tail := [1, 2, 3, 4, 5, 6, 7, 8, nan]
+print min(tail)
+print max(tail)
+short := [2, nan]
+print min(short)
+print max(short)
+clean := [3, -1, 4, 1, 5, 9, 2, 6, 5]
+print min(clean)
+print max(clean)
+print nan == nan
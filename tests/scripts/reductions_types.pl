@@ -0,0 +1,2 @@
+names := ["a", "b"]
+print sum(names)
@@ -0,0 +1,39 @@
+numbers := [5, -2, 3.5, 0, 3.5, 100]
+copy := sorted(numbers)
+for x : copy
+  print x
+print numbers[0]
+sort(numbers)
+print numbers[0]
+print numbers[5]
+print binarySearch(numbers, 3.5) > 1
+print binarySearch(numbers, 100)
+print binarySearch(numbers, 4)
+words := ["pear", "apple", "fig", "Banana"]
+sort(words)
+for w : words
+  print w
+print binarySearch(words, "fig")
+print binarySearch(words, "grape")
+empty: array<number>
+sort(empty)
+print size(empty)
+print binarySearch(empty, 1)
+big: array<number>
+seed := 7
+i := 0
+while i < 50000
+  seed = (seed * 7919 + 13) % 100003
+  add(big, seed)
+  i += 1
+sorted_big := sorted(big)
+ordered := true
+i = 1
+while i < size(sorted_big)
+  if sorted_big[i - 1] > sorted_big[i]
+    ordered = false
+  i += 1
+print ordered
+print size(sorted_big)
+print sum(sorted_big) == sum(big)
+print binarySearch(sorted_big, sorted_big[12345]) > -1
@@ -0,0 +1,2 @@
+flags := [true, false]
+sort(flags)
@@ -0,0 +1,35 @@
+square: (x: number): number
+  return x * x
+label: (name: string, n: number): string
+  print "working on " + name
+  return name + toString(n)
+grow: (values: array<number>): number
+  add(values, 100)
+  return sum(values)
+squarePlusOne: (n: number): number
+  t := spawn square(n)
+  return await t + 1
+a := spawn square(7)
+print await a
+print await a
+b := spawn label("x", 3)
+print "before await"
+print await b
+print await b
+values := [1, 2, 3]
+c := spawn grow(values)
+print await c
+print size(values)
+d := spawn squarePlusOne(4)
+print await d
+pending: array<task<number>>
+i := 0
+while i < 10
+  add(pending, spawn square(i))
+  i += 1
+total := 0
+for t : pending
+  total += await t
+print total
+late := spawn label("late", 1)
+print "end of script"
@@ -0,0 +1,8 @@
+fail: (n: number): number
+  print "started"
+  items := [n]
+  return items[n]
+t := spawn fail(5)
+print "spawned"
+print await t
+print "unreachable"
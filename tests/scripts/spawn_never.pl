@@ -0,0 +1,2 @@
+t: task<number>
+print await t
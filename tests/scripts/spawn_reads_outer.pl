@@ -0,0 +1,7 @@
+limit := 10
+capped: (n: number): number
+  if n > limit
+    return limit
+  return n
+t := spawn capped(20)
+print await t
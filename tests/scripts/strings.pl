@@ -0,0 +1,34 @@
+s := "the quick brown fox jumps over the lazy dog"
+print find(s, "the")
+print find(s, "lazy")
+print find(s, "cat")
+print find(s, "")
+print find("", "a")
+print contains(s, "fox j")
+print contains(s, "foxes")
+print startsWith(s, "the q")
+print startsWith(s, "quick")
+parts := split("a,b,,c", ",")
+print size(parts)
+for p : parts
+  print "[" + p + "]"
+print size(split("no separator", ";"))
+print size(split("", ","))
+print replace(s, "the", "a")
+print replace("aaaa", "aa", "b")
+print replace("abc", "x", "y")
+print "[" + trim("   padded  ") + "]"
+print "[" + trim("   ") + "]"
+long := ""
+i := 0
+while i < 100
+  long += "abcdefgh"
+  i += 1
+long += "needle"
+print find(long, "needle")
+print find(long, "habc")
+print find(long, "hneedle")
+print contains(long, "ghX")
+print size(split(long, "gh"))
+print len(replace(long, "abcdefgh", ""))
+parts = split(s, "")
@@ -0,0 +1 @@
+print replace("abc", "", "x")
@@ -0,0 +1 @@
+print find("abc", 1)
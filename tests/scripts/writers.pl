@@ -0,0 +1,44 @@
+out := openWrite("writers.txt")
+write(out, "value: ")
+writeLine(out, 2.5)
+writeLine(out, true)
+write(out, 1 / 3)
+writeLine(out, "")
+close(out)
+for line : readLines("writers.txt")
+  print line
+big := openWrite("writers_big.txt")
+i := 0
+while i < 40000
+  writeLine(big, "line " + toString(i))
+  i += 1
+close(big)
+close(big)
+count := 0
+last := ""
+for line : readLines("writers_big.txt")
+  count += 1
+  last = line
+print count
+print last
+print len(readFile("writers_big.txt"))
+log := openWrite("writers_parallel.txt")
+ids: array<number>
+i = 0
+while i < 200
+  add(ids, i)
+  i += 1
+parallel for id : ids
+  writeLine(log, "entry " + toString(id))
+close(log)
+entries := split(readFile("writers_parallel.txt"), "entry ")
+print size(entries) - 1
+whole := 0
+for line : readLines("writers_parallel.txt")
+  if startsWith(line, "entry ") & len(line) <= 9
+    whole += 1
+print whole
+reopened := openWrite("writers.txt")
+close(reopened)
+print len(readFile("writers.txt"))
+write(reopened, "late")
@@ -0,0 +1 @@
+w := openWrite("writers_no_such_directory/file.txt")
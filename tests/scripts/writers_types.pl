@@ -0,0 +1,3 @@
+w := openWrite("writers_types.txt")
+values := [1, 2]
+writeLine(w, values)